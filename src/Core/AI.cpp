@@ -1,25 +1,22 @@
 #include "AI.hpp"
 
 #include "Entity.hpp"
+#include "Strategies/AttackStrategies.hpp"
+#include "Strategies/MovementStrategies.hpp"
 #include "World.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <limits>
+#include <optional>
 #include <random>
 #include <ranges>
 #include <vector>
 
 namespace sw::core::detail
 {
-	auto randomEngine() -> std::mt19937&
+	void shuffleEnemies(std::vector<Entity*>& enemies, std::mt19937& rng)
 	{
-		static std::mt19937 engine(std::random_device{}());
-		return engine;
-	}
-
-	void shuffleEnemies(std::vector<Entity*>& enemies)
-	{
-		auto& rng = randomEngine();
 		std::ranges::shuffle(enemies, rng);
 	}
 
@@ -29,17 +26,83 @@ namespace sw::core::detail
 		enemies.reserve(world.entities().size());
 		for (auto& entity : world.entities() | std::views::values)
 		{
-			if (!entity || entity->id() == self.id() || !entity->isAlive())
+			if (!entity || !self.isHostileTo(*entity) || !world.isAlive(*entity))
 			{
 				continue;
 			}
 			enemies.push_back(entity.get());
 		}
 
-		shuffleEnemies(enemies);
+		sortInTurnOrder(enemies);
+		shuffleEnemies(enemies, world.randomEngine());
+		return enemies;
+	}
+
+	auto gatherEnemiesInRange(const Entity& self, World& world, const RangeValue radius) -> std::vector<Entity*>
+	{
+		std::vector<Entity*> enemies;
+		world.map().forEachHostileInRange(
+			self.position(),
+			radius,
+			self.faction(),
+			[&](const SpatialIndex::Entry& entry)
+			{
+				if (auto* entity = world.getEntity(entry.id);
+					entity != nullptr && self.isHostileTo(*entity) && world.isAlive(*entity))
+				{
+					enemies.push_back(entity);
+				}
+			});
+
+		sortInTurnOrder(enemies);
+		shuffleEnemies(enemies, world.randomEngine());
 		return enemies;
 	}
 
+	auto findNearestHostile(const Entity& self, World& world) -> Entity*
+	{
+		std::vector<SpatialIndex::Entry> entries;
+		world.map().collectNearestHostile(
+			self.position(),
+			self.faction(),
+			[&](const SpatialIndex::Entry& entry)
+			{
+				const auto* entity = world.getEntity(entry.id);
+				return entity != nullptr && self.isHostileTo(*entity) && world.isAlive(*entity);
+			},
+			entries);
+
+		std::vector<Entity*> nearest;
+		nearest.reserve(entries.size());
+		for (const auto& entry : entries)
+		{
+			nearest.push_back(world.getEntity(entry.id));
+		}
+
+		if (nearest.size() <= 1)
+		{
+			return nearest.empty() ? nullptr : nearest.front();
+		}
+		sortInTurnOrder(nearest);
+		std::uniform_int_distribution<size_t> pick(0, nearest.size() - 1);
+		return nearest[pick(world.randomEngine())];
+	}
+
+	auto usesSpatialTargeting(const World& world) -> bool
+	{
+		return world.aiOptions().stickyTargets || world.map().hasFactions();
+	}
+
+	auto maxReach(const Entity& self) -> RangeValue
+	{
+		RangeValue reach = 0;
+		for (const auto& attack : self.attacks())
+		{
+			reach = std::max(reach, attack->reach());
+		}
+		return reach;
+	}
+
 	auto findNearestEnemy(const Entity& self, const std::vector<Entity*>& enemies) -> Entity*
 	{
 		Entity* nearest = nullptr;
@@ -55,4 +118,100 @@ namespace sw::core::detail
 		}
 		return nearest;
 	}
+
+	auto PursuitCache::repeat(Entity& self, World& world, const TurnNumber turn) -> std::optional<bool>
+	{
+		if (!_target || !world.aiOptions().incremental)
+		{
+			return std::nullopt;
+		}
+
+		const Entity* target = world.getEntity(*_target);
+		if (target == nullptr || !world.isAlive(*target))
+		{
+			forget();
+			return std::nullopt;
+		}
+
+		const uint32_t distance = self.position().distanceTo(target->position());
+		if (distance <= maxReach(self) || world.map().changedSince(self.position(), distance, _stamp))
+		{
+			forget();
+			return std::nullopt;
+		}
+
+		const bool moved = world.moveEntityTowards(self, target->position(), turn);
+		_stamp = world.map().changeStamp();
+		return moved;
+	}
+
+	void PursuitCache::remember(const Entity& self, const World& world, const Entity& target)
+	{
+		// The nearest-enemy argument relies on closing in by exactly one cell per step
+		const auto movement = self.movement();
+		if (!world.aiOptions().incremental || !movement || (*movement)->stepSize() != 1U)
+		{
+			forget();
+			return;
+		}
+
+		_target = target.id();
+		_stamp = world.map().changeStamp();
+	}
+
+	auto PursuitCache::pending(const Entity& self, const World& world) const -> std::optional<UnitId>
+	{
+		if (!_target)
+		{
+			return std::nullopt;
+		}
+
+		// Map stamps are rebuilt on restore, so only a decision no change has touched yet survives
+		const Entity* target = world.getEntity(*_target);
+		if (target == nullptr || !world.isAlive(*target)
+			|| world.map().changedSince(self.position(), self.position().distanceTo(target->position()), _stamp))
+		{
+			return std::nullopt;
+		}
+		return _target;
+	}
+
+	void PursuitCache::restore(const std::optional<UnitId> target, const World& world)
+	{
+		_target = target;
+		_stamp = world.map().changeStamp();
+	}
+
+	auto pursue(Entity& self, World& world, const TurnNumber turn, const Entity* target, PursuitCache& pursuit) -> bool
+	{
+		if (target != nullptr && world.moveEntityTowards(self, target->position(), turn))
+		{
+			pursuit.remember(self, world, *target);
+			return true;
+		}
+
+		pursuit.forget();
+		return false;
+	}
+
+	auto TargetLock::attack(Entity& self, World& world, const TurnNumber turn, const AttackType preferred) -> bool
+	{
+		if (!_target)
+		{
+			return false;
+		}
+
+		Entity* target = world.getEntity(*_target);
+		if (target == nullptr || !world.isAlive(*target) || !world.executeAttack(self, *target, turn, preferred))
+		{
+			release();
+			return false;
+		}
+		return true;
+	}
+
+	void TargetLock::lock(const Entity& target)
+	{
+		_target = target.id();
+	}
 }
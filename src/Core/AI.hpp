@@ -8,14 +8,21 @@
  * autonomous decision-making behavior for entities.
  *
  * Key responsibilities:
- * - Enemy detection and gathering
+ * - Enemy detection and gathering, faction-aware
  * - Target selection algorithms
  * - Random number generation for AI decisions
+ * - Caching of pursuit decisions for incremental re-evaluation
+ * - Sticky attack targets
  * - Utility functions for AI strategy implementations
  */
 
 #pragma once
 
+#include "Types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
 #include <random>
 #include <vector>
 
@@ -36,16 +43,27 @@ namespace sw::core
 	namespace detail
 	{
 		/**
-		 * @brief Get the global random number engine for AI decisions
-		 * @return Reference to the shared random number generator
+		 * @brief Shuffle a vector of enemies to add randomness to target selection
+		 * @param enemies Vector of enemy entities to shuffle
+		 * @param rng Random engine of the world the enemies belong to
 		 */
-		auto randomEngine() -> std::mt19937&;
+		void shuffleEnemies(std::vector<Entity*>& enemies, std::mt19937& rng);
 
 		/**
-		 * @brief Shuffle a vector of enemies to add randomness to target selection
-		 * @param enemies Vector of enemy entities to shuffle
+		 * @brief Put candidate units in turn order
+		 *
+		 * Containers keyed by unit or by map cell are iterated in an order that
+		 * depends on the insertion and move history, which a resumed run does
+		 * not share. Sorting by slot before shuffling, picking or hitting makes
+		 * those choices depend only on the current state.
+		 *
+		 * @param entities Candidate units, sorted in place
 		 */
-		void shuffleEnemies(std::vector<Entity*>& enemies);
+		template <class TEntity>
+		void sortInTurnOrder(std::vector<TEntity*>& entities)
+		{
+			std::ranges::sort(entities, {}, &TEntity::slot);
+		}
 
 		/**
 		 * @brief Gather all enemy entities from the world
@@ -55,6 +73,46 @@ namespace sw::core
 		 */
 		auto gatherEnemies(const Entity& self, World& world) -> std::vector<Entity*>;
 
+		/**
+		 * @brief Find the nearest hostile unit using the map's per-faction spatial indexes
+		 *
+		 * Searches outward from the entity, so the cost depends on the distance
+		 * to the nearest enemy rather than the number of units. Ties are broken
+		 * with the world's random engine.
+		 *
+		 * @param self The entity performing the search
+		 * @param world The world to search for enemies
+		 * @return Pointer to a nearest enemy, or nullptr if there is none
+		 */
+		auto findNearestHostile(const Entity& self, World& world) -> Entity*;
+
+		/**
+		 * @brief Check whether an AI should pick targets through spatial queries
+		 *
+		 * Spatial targeting is used with sticky targets and whenever factions are
+		 * in play; otherwise the original scan over every unit is kept.
+		 *
+		 * @param world The world the AI acts in
+		 * @return true if targets should come from the map's spatial indexes
+		 */
+		auto usesSpatialTargeting(const World& world) -> bool;
+
+		/**
+		 * @brief Gather living enemies within a radius using the map's spatial index
+		 * @param self The entity performing the search
+		 * @param world The world to search for enemies
+		 * @param radius Chebyshev search radius
+		 * @return Enemies within the radius, shuffled with the world's random engine
+		 */
+		auto gatherEnemiesInRange(const Entity& self, World& world, RangeValue radius) -> std::vector<Entity*>;
+
+		/**
+		 * @brief Get the longest reach of an entity's attacks
+		 * @param self The entity to inspect
+		 * @return Maximum attack reach, or 0 if the entity cannot attack
+		 */
+		auto maxReach(const Entity& self) -> RangeValue;
+
 		/**
 		 * @brief Find the nearest enemy from a list of enemies
 		 * @param self The entity performing the search
@@ -62,6 +120,135 @@ namespace sw::core
 		 * @return Pointer to the nearest enemy, or nullptr if no enemies
 		 */
 		auto findNearestEnemy(const Entity& self, const std::vector<Entity*>& enemies) -> Entity*;
+
+		/**
+		 * @brief Remembers which enemy a unit last stepped towards
+		 *
+		 * When incremental AI is enabled in World::aiOptions(), a unit that moved towards its
+		 * nearest enemy repeats that step on later turns instead of gathering and
+		 * trying every enemy again, as long as:
+		 * - the target is still alive and out of attack reach, and
+		 * - no unit was placed, moved or removed within the distance to the target
+		 *   since the decision (the unit's own step excluded).
+		 *
+		 * Under those conditions no enemy can have become attackable or strictly
+		 * nearer, so the cached step is a decision the full evaluation could have
+		 * made; ties are kept as they were last broken by the world's random
+		 * engine. The engine is only drawn from on full evaluations, so runs stay
+		 * reproducible for a given seed but differ from runs without caching.
+		 */
+		class PursuitCache
+		{
+		public:
+			/**
+			 * @brief Repeat the cached step if the neighbourhood is unchanged
+			 * @param self The entity controlled by the AI
+			 * @param world The world containing the entity
+			 * @param turn Current turn number
+			 * @return Result of the repeated step, or nullopt if the AI must re-evaluate
+			 */
+			auto repeat(Entity& self, World& world, TurnNumber turn) -> std::optional<bool>;
+
+			/**
+			 * @brief Record a step towards a target decided by a full evaluation
+			 * @param self The entity that just moved
+			 * @param world The world containing the entity
+			 * @param target The enemy the entity moved towards
+			 */
+			void remember(const Entity& self, const World& world, const Entity& target);
+
+			/**
+			 * @brief Drop the cached decision
+			 */
+			void forget() noexcept
+			{
+				_target.reset();
+			}
+
+			/**
+			 * @brief Get the cached target if nothing has invalidated the decision yet, for checkpoints
+			 * @param self The entity controlled by the AI
+			 * @param world The world containing the entity
+			 * @return Target the next turn may keep stepping towards, or nullopt
+			 */
+			[[nodiscard]]
+			auto pending(const Entity& self, const World& world) const -> std::optional<UnitId>;
+
+			/**
+			 * @brief Restore a cached target from a checkpoint, watching for changes from now on
+			 * @param target Target returned by pending() when the checkpoint was taken
+			 * @param world The restored world
+			 */
+			void restore(std::optional<UnitId> target, const World& world);
+
+		private:
+			std::optional<UnitId> _target;	///< Enemy the unit last stepped towards
+			uint64_t _stamp{0};				///< Map change stamp right after that step
+		};
+
+		/**
+		 * @brief Step towards an enemy, recording the decision in a pursuit cache
+		 * @param self The entity controlled by the AI
+		 * @param world The world containing the entity
+		 * @param turn Current turn number
+		 * @param target Nearest enemy, or nullptr if there is none
+		 * @param pursuit Cache updated with the decision
+		 * @return true if the entity moved
+		 */
+		auto pursue(Entity& self, World& world, TurnNumber turn, const Entity* target, PursuitCache& pursuit) -> bool;
+
+		/**
+		 * @brief Holds the enemy an AI keeps attacking while sticky targets are enabled
+		 */
+		class TargetLock
+		{
+		public:
+			/**
+			 * @brief Attack the locked target, releasing it if it is gone or out of reach
+			 * @param self The attacking entity
+			 * @param world The world containing the entity
+			 * @param turn Current turn number
+			 * @param preferred Attack type to try first
+			 * @return true if the locked target was attacked
+			 */
+			auto attack(Entity& self, World& world, TurnNumber turn, AttackType preferred) -> bool;
+
+			/**
+			 * @brief Lock onto a target
+			 * @param target Enemy that was just attacked
+			 */
+			void lock(const Entity& target);
+
+			/**
+			 * @brief Drop the locked target
+			 */
+			void release() noexcept
+			{
+				_target.reset();
+			}
+
+			/**
+			 * @brief Get the locked target
+			 * @return Locked enemy id, or nullopt if nothing is locked
+			 */
+			[[nodiscard]]
+			auto target() const noexcept -> std::optional<UnitId>
+			{
+				return _target;
+			}
+
+			/**
+			 * @brief Replace the locked target, e.g. when resuming from a checkpoint
+			 * @param target Enemy id to lock, or nullopt to release
+			 */
+			void restore(std::optional<UnitId> target) noexcept
+			{
+				_target = target;
+			}
+
+		private:
+			std::optional<UnitId> _target;	///< Enemy currently being attacked
+		};
 	}
 
 }
@@ -0,0 +1,101 @@
+#include "ActivityScheduler.hpp"
+
+#include "Core/Types.hpp"
+#include "Entity.hpp"
+#include "World.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace sw::core
+{
+
+	void ActivityScheduler::assign(const std::vector<UnitId>& order, const std::span<const UnitId> sleeping)
+	{
+		_sleeping.clear();
+		_sleeping.insert(sleeping.begin(), sleeping.end());
+		_active.clear();
+		std::ranges::copy_if(order, std::back_inserter(_active), [this](const UnitId id) { return !isAsleep(id); });
+		_woken.clear();
+	}
+
+	void ActivityScheduler::addUnit(const UnitId id)
+	{
+		_woken.push_back(id);
+	}
+
+	auto ActivityScheduler::isIdle(const Entity& self, const World& world) const -> bool
+	{
+		bool idle = true;
+		world.map().forEachUnitInRange(
+			self.position(),
+			_wakeRadius,
+			[&](const SpatialIndex::Entry& entry)
+			{
+				if (entry.id == self.id())
+				{
+					return;
+				}
+				if (const auto* other = world.getEntity(entry.id); other != nullptr && world.isAlive(*other))
+				{
+					idle = false;
+				}
+			});
+		return idle;
+	}
+
+	void ActivityScheduler::sleep(const UnitId id)
+	{
+		_sleeping.insert(id);
+	}
+
+	void ActivityScheduler::wakeAround(const World& world, const Position position)
+	{
+		if (_sleeping.empty())
+		{
+			return;
+		}
+
+		world.map().forEachUnitInRange(
+			position,
+			_wakeRadius,
+			[this](const SpatialIndex::Entry& entry)
+			{
+				if (_sleeping.erase(entry.id) != 0)
+				{
+					_woken.push_back(entry.id);
+				}
+			});
+	}
+
+	auto ActivityScheduler::activeUnits(const World& world) -> const std::vector<UnitId>&
+	{
+		std::erase_if(
+			_active,
+			[&](const UnitId id) { return world.getEntity(id) == nullptr || _sleeping.contains(id); });
+
+		if (_woken.empty())
+		{
+			return _active;
+		}
+
+		// Slots follow turn order, so sorting by slot restores creation order
+		std::erase_if(_woken, [&](const UnitId id) { return world.getEntity(id) == nullptr; });
+		auto bySlot = [&](const UnitId lhs, const UnitId rhs)
+		{ return world.getEntity(lhs)->slot() < world.getEntity(rhs)->slot(); };
+		std::ranges::sort(_woken, bySlot);
+
+		_merged.clear();
+		_merged.reserve(_active.size() + _woken.size());
+		std::ranges::merge(_active, _woken, std::back_inserter(_merged), bySlot);
+		const auto [first, last] = std::ranges::unique(_merged);
+		_merged.erase(first, last);
+
+		std::swap(_active, _merged);
+		_woken.clear();
+		return _active;
+	}
+
+}
@@ -0,0 +1,125 @@
+/**
+ * @file ActivityScheduler.hpp
+ * @brief Event-driven scheduling that keeps idle units out of the turn loop.
+ *
+ * In large battles most units are far from everyone else. The scheduler puts a
+ * unit to sleep when it has no march order and no other unit within its wake
+ * radius, and wakes it when the spatial index reports a unit arriving within
+ * that radius. Only awake units are visited each turn, so per-turn cost scales
+ * with the number of active units rather than the total.
+ *
+ * Key responsibilities:
+ * - Tracking the awake set in turn order
+ * - Sleep decisions based on neighbourhood queries
+ * - Waking sleepers around cells where units move or spawn
+ */
+
+#pragma once
+
+#include "Types.hpp"
+
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+namespace sw::core
+{
+
+	class Entity;
+	class World;
+
+	/**
+	 * @brief Tracks which units take part in the turn loop
+	 *
+	 * Sleeping units skip their AI entirely. Because the wake radius is at least
+	 * the longest attack reach of any unit, a sleeper can only be attacked by a
+	 * unit that moved or spawned within its radius, which wakes it first.
+	 */
+	class ActivityScheduler
+	{
+	public:
+		/**
+		 * @brief Start scheduling with every unit awake except the given sleepers
+		 * @param order Unit identifiers in turn order
+		 * @param sleeping Units that start asleep, e.g. restored from a checkpoint
+		 */
+		void assign(const std::vector<UnitId>& order, std::span<const UnitId> sleeping = {});
+
+		/**
+		 * @brief Set the wake radius
+		 * @param radius Chebyshev distance within which another unit keeps a unit awake
+		 */
+		void setWakeRadius(RangeValue radius) noexcept
+		{
+			_wakeRadius = radius;
+		}
+
+		/**
+		 * @brief Get the wake radius
+		 * @return Chebyshev wake distance
+		 */
+		[[nodiscard]]
+		auto wakeRadius() const noexcept -> RangeValue
+		{
+			return _wakeRadius;
+		}
+
+		/**
+		 * @brief Register a unit spawned after scheduling started (it starts awake)
+		 * @param id Unit identifier
+		 */
+		void addUnit(UnitId id);
+
+		/**
+		 * @brief Decide whether a unit has nothing to react to
+		 * @param self Unit to check
+		 * @param world World containing the unit
+		 * @return true if no other living unit is within the wake radius
+		 */
+		[[nodiscard]]
+		auto isIdle(const Entity& self, const World& world) const -> bool;
+
+		/**
+		 * @brief Check whether a unit is asleep
+		 * @param id Unit identifier
+		 * @return true if the unit sleeps until something moves or spawns within its wake radius
+		 */
+		[[nodiscard]]
+		auto isAsleep(UnitId id) const -> bool
+		{
+			return _sleeping.contains(id);
+		}
+
+		/**
+		 * @brief Put a unit to sleep; it leaves the active list at the next turn
+		 * @param id Unit identifier
+		 */
+		void sleep(UnitId id);
+
+		/**
+		 * @brief Wake every sleeper whose wake radius covers a cell
+		 * @param world World used for the neighbourhood query
+		 * @param position Cell a unit moved to or spawned at
+		 */
+		void wakeAround(const World& world, Position position);
+
+		/**
+		 * @brief Get the units to visit this turn, in turn order
+		 *
+		 * Drops sleepers and removed units and merges in units woken since the
+		 * previous call.
+		 *
+		 * @param world World used to resolve turn-order slots
+		 * @return Awake unit identifiers in turn order
+		 */
+		auto activeUnits(const World& world) -> const std::vector<UnitId>&;
+
+	private:
+		std::vector<UnitId> _active;			///< Awake units in turn order
+		std::vector<UnitId> _woken;				///< Units woken since the last activeUnits() call
+		std::vector<UnitId> _merged;			///< Scratch buffer for merging woken units
+		std::unordered_set<UnitId> _sleeping;	///< Units currently asleep
+		RangeValue _wakeRadius{1};				///< Chebyshev wake distance
+	};
+
+}
@@ -0,0 +1,318 @@
+#include "Checkpoint.hpp"
+
+#include "Core/Types.hpp"
+#include "Entity.hpp"
+#include "IO/System/BinaryStream.hpp"
+#include "Prefabs.hpp"
+#include "Strategies/AttackStrategies.hpp"
+#include "UnitCatalog.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace sw::core
+{
+	namespace
+	{
+		constexpr uint32_t CheckpointMagic = 0x4B435753;  // "SWCK"
+
+		void writeOptionalId(io::BinaryWriter& writer, const std::optional<UnitId> id)
+		{
+			writer.write(static_cast<uint8_t>(id ? 1 : 0));
+			writer.write(id.value_or(0));
+		}
+
+		auto readOptionalId(io::BinaryReader& reader) -> std::optional<UnitId>
+		{
+			const bool present = reader.read<uint8_t>() != 0;
+			const auto id = reader.read<UnitId>();
+			return present ? std::optional(id) : std::nullopt;
+		}
+
+		auto findAttack(const CheckpointUnit& unit, AttackType type) -> const CheckpointAttack*
+		{
+			const auto it = std::ranges::find(unit.attacks, type, &CheckpointAttack::type);
+			return it != unit.attacks.end() ? &*it : nullptr;
+		}
+
+		auto requireAttack(const CheckpointUnit& unit, AttackType type) -> const CheckpointAttack&
+		{
+			const auto* attack = findAttack(unit, type);
+			if (attack == nullptr)
+			{
+				throw std::runtime_error("Checkpoint unit " + std::to_string(unit.id) + " is missing an attack");
+			}
+			return *attack;
+		}
+
+		auto restoreUnitComponents(const CheckpointUnit& unit, const UnitCatalog& catalog) -> std::unique_ptr<Entity>
+		{
+			if (unit.typeName == "Swordsman")
+			{
+				return makeSwordsman(
+					unit.id,
+					unit.position,
+					SwordsmanConfig{.hp = unit.hp, .strength = requireAttack(unit, AttackType::Melee).damage});
+			}
+
+			if (unit.typeName == "Hunter")
+			{
+				const auto& ranged = requireAttack(unit, AttackType::Ranged);
+				return makeHunter(
+					unit.id,
+					unit.position,
+					HunterConfig{
+						.hp = unit.hp,
+						.agility = ranged.damage,
+						.strength = requireAttack(unit, AttackType::Melee).damage,
+						.range = ranged.maxRange});
+			}
+
+			if (unit.typeName == "Grenadier")
+			{
+				const auto& splash = requireAttack(unit, AttackType::Splash);
+				return makeGrenadier(
+					unit.id,
+					unit.position,
+					GrenadierConfig{
+						.hp = unit.hp,
+						.strength = requireAttack(unit, AttackType::Melee).damage,
+						.power = splash.damage,
+						.range = splash.maxRange,
+						.radius = splash.radius});
+			}
+
+			if (const auto* unitTemplate = catalog.find(unit.typeName))
+			{
+				return unitTemplate->restore(unit);
+			}
+
+			throw std::runtime_error("Checkpoint contains unknown unit type: " + unit.typeName);
+		}
+	}
+
+	auto captureUnit(const Entity& entity) -> CheckpointUnit
+	{
+		CheckpointUnit unit;
+		unit.id = entity.id();
+		unit.typeName = entity.typeName();
+		unit.position = entity.position();
+		unit.faction = entity.faction();
+		if (const auto health = entity.health())
+		{
+			unit.hp = (*health)->hitPoints();
+		}
+
+		for (const auto& attack : entity.attacks())
+		{
+			CheckpointAttack record{.type = attack->type(), .damage = attack->damage()};
+			if (const auto* ranged = dynamic_cast<const RangedAttackStrategy*>(attack.get()))
+			{
+				record.minRange = ranged->minRange();
+				record.maxRange = ranged->maxRange();
+				record.requireClearAdjacency = ranged->requiresClearAdjacency();
+			}
+			else if (const auto* splash = dynamic_cast<const SplashAttackStrategy*>(attack.get()))
+			{
+				record.minRange = splash->minRange();
+				record.maxRange = splash->maxRange();
+				record.radius = splash->radius();
+			}
+			unit.attacks.push_back(record);
+		}
+		if (const auto ai = entity.ai())
+		{
+			unit.lockedTarget = (*ai)->lockedTarget();
+		}
+		return unit;
+	}
+
+	auto restoreUnit(const CheckpointUnit& unit, const UnitCatalog& catalog) -> std::unique_ptr<Entity>
+	{
+		auto entity = restoreUnitComponents(unit, catalog);
+		entity->setFaction(unit.faction);
+		if (const auto ai = entity->ai())
+		{
+			(*ai)->restoreLockedTarget(unit.lockedTarget);
+		}
+		return entity;
+	}
+
+	void writeCheckpoint(const std::filesystem::path& path, const CheckpointData& data)
+	{
+		auto tempPath = path;
+		tempPath += ".tmp";
+
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				throw std::runtime_error("Failed to open checkpoint file for writing: " + tempPath.string());
+			}
+
+			io::BinaryWriter writer(file);
+			writer.write(CheckpointMagic);
+			writer.write(CheckpointVersion);
+			writer.write(data.dimensions.width);
+			writer.write(data.dimensions.height);
+			writer.write(data.nextTurn);
+			writer.write(data.rngState);
+
+			writer.write(static_cast<uint32_t>(data.units.size()));
+			for (const auto& unit : data.units)
+			{
+				writer.write(unit.id);
+				writer.write(unit.typeName);
+				writer.write(unit.position.x);
+				writer.write(unit.position.y);
+				writer.write(unit.hp);
+				writer.write(unit.faction);
+				writer.write(static_cast<uint8_t>(unit.attacks.size()));
+				for (const auto& attack : unit.attacks)
+				{
+					writer.write(static_cast<uint8_t>(attack.type));
+					writer.write(attack.damage);
+					writer.write(attack.minRange);
+					writer.write(attack.maxRange);
+					writer.write(static_cast<uint8_t>(attack.requireClearAdjacency ? 1 : 0));
+					writer.write(attack.radius);
+				}
+				writeOptionalId(writer, unit.lockedTarget);
+				writer.write(static_cast<uint8_t>(unit.asleep ? 1 : 0));
+				writeOptionalId(writer, unit.pursuitTarget);
+			}
+
+			writer.write(static_cast<uint32_t>(data.marches.size()));
+			for (const auto& [id, target] : data.marches)
+			{
+				writer.write(id);
+				writer.write(target.x);
+				writer.write(target.y);
+			}
+
+			writer.write(data.startTurn);
+			writer.write(data.lastDamageTurn);
+			writer.write(static_cast<uint32_t>(data.recentHashes.size()));
+			for (const uint64_t hash : data.recentHashes)
+			{
+				writer.write(hash);
+			}
+			writer.write(data.wakeRadius);
+			writer.write(static_cast<uint32_t>(data.commands.size()));
+			for (const auto& command : data.commands)
+			{
+				writer.write(command.turn);
+				writer.write(command.sequence);
+				writer.write(command.commandLine);
+			}
+
+			file.flush();
+			if (!file)
+			{
+				throw std::runtime_error("Failed to write checkpoint file: " + tempPath.string());
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error)
+		{
+			throw std::runtime_error("Failed to replace checkpoint file " + path.string() + ": " + error.message());
+		}
+	}
+
+	auto readCheckpoint(const std::filesystem::path& path) -> CheckpointData
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			throw std::runtime_error("Failed to open checkpoint file: " + path.string());
+		}
+
+		io::BinaryReader reader(file);
+		if (reader.read<uint32_t>() != CheckpointMagic)
+		{
+			throw std::runtime_error("Not a checkpoint file: " + path.string());
+		}
+		const auto version = reader.read<uint32_t>();
+		if (version != CheckpointVersion)
+		{
+			throw std::runtime_error("Unsupported checkpoint version " + std::to_string(version));
+		}
+
+		CheckpointData data;
+		data.dimensions.width = reader.read<uint32_t>();
+		data.dimensions.height = reader.read<uint32_t>();
+		data.nextTurn = reader.read<TurnNumber>();
+		data.rngState = reader.readString();
+
+		const auto unitCount = reader.read<uint32_t>();
+		data.units.reserve(unitCount);
+		for (uint32_t i = 0; i < unitCount; ++i)
+		{
+			CheckpointUnit unit;
+			unit.id = reader.read<UnitId>();
+			unit.typeName = reader.readString();
+			unit.position.x = reader.read<uint32_t>();
+			unit.position.y = reader.read<uint32_t>();
+			unit.hp = reader.read<HealthPoints>();
+			unit.faction = reader.read<FactionId>();
+			const auto attackCount = reader.read<uint8_t>();
+			for (uint8_t a = 0; a < attackCount; ++a)
+			{
+				CheckpointAttack attack;
+				attack.type = static_cast<AttackType>(reader.read<uint8_t>());
+				attack.damage = reader.read<DamageValue>();
+				attack.minRange = reader.read<RangeValue>();
+				attack.maxRange = reader.read<RangeValue>();
+				attack.requireClearAdjacency = reader.read<uint8_t>() != 0;
+				attack.radius = reader.read<RangeValue>();
+				unit.attacks.push_back(attack);
+			}
+			unit.lockedTarget = readOptionalId(reader);
+			unit.asleep = reader.read<uint8_t>() != 0;
+			unit.pursuitTarget = readOptionalId(reader);
+			data.units.push_back(std::move(unit));
+		}
+
+		const auto marchCount = reader.read<uint32_t>();
+		data.marches.reserve(marchCount);
+		for (uint32_t i = 0; i < marchCount; ++i)
+		{
+			const auto id = reader.read<UnitId>();
+			Position target;
+			target.x = reader.read<uint32_t>();
+			target.y = reader.read<uint32_t>();
+			data.marches.emplace_back(id, target);
+		}
+
+		data.startTurn = reader.read<TurnNumber>();
+		data.lastDamageTurn = reader.read<TurnNumber>();
+		const auto hashCount = reader.read<uint32_t>();
+		data.recentHashes.reserve(hashCount);
+		for (uint32_t i = 0; i < hashCount; ++i)
+		{
+			data.recentHashes.push_back(reader.read<uint64_t>());
+		}
+		data.wakeRadius = reader.read<RangeValue>();
+
+		const auto commandCount = reader.read<uint32_t>();
+		data.commands.reserve(commandCount);
+		for (uint32_t i = 0; i < commandCount; ++i)
+		{
+			CheckpointCommand command;
+			command.turn = reader.read<TurnNumber>();
+			command.sequence = reader.read<uint64_t>();
+			command.commandLine = reader.readString();
+			data.commands.push_back(std::move(command));
+		}
+
+		return data;
+	}
+
+}
@@ -0,0 +1,138 @@
+/**
+ * @file Checkpoint.hpp
+ * @brief Versioned binary checkpoint format for suspending and resuming simulations.
+ *
+ * A checkpoint captures everything needed to continue a simulation from a turn
+ * boundary without replaying the scenario commands: map dimensions, every unit
+ * in turn order with its current stats, the pending march targets, the next turn
+ * number, the state of the AI random engine, the progress of the stalemate rules,
+ * which units are asleep, which cached pursuit decisions still hold and the
+ * commands scheduled for later turns.
+ *
+ * Key responsibilities:
+ * - Capturing entities into plain records and rebuilding them through prefabs or the unit catalog
+ * - Versioned little-endian encoding of the checkpoint image
+ * - Atomic on-disk replacement (write to a temporary file, then rename)
+ */
+
+#pragma once
+
+#include "Core/Types.hpp"
+#include "Map.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sw::core
+{
+
+	class Entity;
+	class UnitCatalog;
+
+	/**
+	 * @brief Checkpoint file format version, bumped on any layout change
+	 */
+	inline constexpr uint32_t CheckpointVersion = 1;
+
+	/**
+	 * @brief Serialized form of a single attack component
+	 */
+	struct CheckpointAttack
+	{
+		AttackType type{AttackType::Melee};
+		DamageValue damage{};
+		RangeValue minRange{};
+		RangeValue maxRange{};
+		bool requireClearAdjacency = false;
+		RangeValue radius{};
+	};
+
+	/**
+	 * @brief Serialized form of a single unit
+	 */
+	struct CheckpointUnit
+	{
+		UnitId id{};
+		std::string typeName;
+		Position position;
+		HealthPoints hp{};
+		FactionId faction{NoFaction};
+		std::vector<CheckpointAttack> attacks;
+		std::optional<UnitId> lockedTarget;	  ///< Enemy kept by the AI under sticky targets
+		bool asleep = false;				  ///< Left out of the turn loop until woken
+		std::optional<UnitId> pursuitTarget;  ///< Enemy a cached step still heads for under incremental AI
+	};
+
+	/**
+	 * @brief Serialized form of a command line scheduled for a later turn
+	 */
+	struct CheckpointCommand
+	{
+		TurnNumber turn{};
+		uint64_t sequence{};  ///< Scheduling order among commands due at the same turn
+		std::string commandLine;
+	};
+
+	/**
+	 * @brief Complete simulation image stored in a checkpoint file
+	 */
+	struct CheckpointData
+	{
+		Map::Dimensions dimensions{.width = 0, .height = 0};
+		TurnNumber nextTurn{1};							  ///< First turn to run after resuming
+		std::string rngState;							  ///< Textual state of the AI random engine
+		std::vector<CheckpointUnit> units;				  ///< Units in turn order
+		std::vector<std::pair<UnitId, Position>> marches;  ///< Pending march targets
+		TurnNumber startTurn{1};						  ///< Turn the checkpointed run started at
+		TurnNumber lastDamageTurn{0};					  ///< Last turn in which damage was applied
+		std::vector<uint64_t> recentHashes;				  ///< Repeated-state window, oldest first
+		RangeValue wakeRadius{0};						  ///< Wake radius of idle-unit scheduling, 0 if it was off
+		std::vector<CheckpointCommand> commands;		  ///< Scheduled commands not yet run
+	};
+
+	/**
+	 * @brief Periodic checkpointing configuration
+	 */
+	struct CheckpointConfig
+	{
+		std::filesystem::path path;	 ///< Destination file, replaced atomically on each write
+		TurnNumber interval{0};		 ///< Write a checkpoint every N turns (0 disables checkpointing)
+	};
+
+	/**
+	 * @brief Capture an entity into a checkpoint record
+	 * @param entity Entity to capture
+	 * @return Plain record describing the entity
+	 */
+	auto captureUnit(const Entity& entity) -> CheckpointUnit;
+
+	/**
+	 * @brief Rebuild an entity from a checkpoint record using the prefab factories
+	 * @param unit Record to restore
+	 * @param catalog Catalog consulted for types that are not built-in prefabs
+	 * @return Newly created entity
+	 * @throws std::runtime_error if the unit type is unknown
+	 */
+	auto restoreUnit(const CheckpointUnit& unit, const UnitCatalog& catalog) -> std::unique_ptr<Entity>;
+
+	/**
+	 * @brief Write a checkpoint image, replacing the destination atomically
+	 * @param path Destination file
+	 * @param data Checkpoint image
+	 * @throws std::runtime_error on I/O failure
+	 */
+	void writeCheckpoint(const std::filesystem::path& path, const CheckpointData& data);
+
+	/**
+	 * @brief Read a checkpoint image
+	 * @param path Source file
+	 * @return Decoded checkpoint image
+	 * @throws std::runtime_error on I/O failure, bad magic or unsupported version
+	 */
+	auto readCheckpoint(const std::filesystem::path& path) -> CheckpointData;
+
+}
@@ -18,11 +18,14 @@ namespace sw::core
 	Entity::Entity(const UnitId id, const Position position, std::string typeName) :
 			_id(id),
 			_position(position),
-			_typeName(std::move(typeName))
+			_typeName(std::move(typeName)),
+			_flags(CustomHealthFlag)
 	{}
 
 	void Entity::setHealth(std::unique_ptr<IHealthStrategy> health)
 	{
+		const bool basic = health != nullptr && dynamic_cast<const BasicHealthStrategy*>(health.get()) != nullptr;
+		_flags = static_cast<uint8_t>(basic ? (_flags & ~CustomHealthFlag) : (_flags | CustomHealthFlag));
 		_health = std::move(health);
 	}
 
@@ -35,12 +38,12 @@ namespace sw::core
 		return std::nullopt;
 	}
 
-	void Entity::setMovement(std::unique_ptr<IMovementStrategy> movement)
+	void Entity::setMovement(std::shared_ptr<const IMovementStrategy> movement)
 	{
 		_movement = std::move(movement);
 	}
 
-	auto Entity::movement() const -> std::optional<IMovementStrategy*>
+	auto Entity::movement() const -> std::optional<const IMovementStrategy*>
 	{
 		if (_movement.has_value())
 		{
@@ -49,12 +52,12 @@ namespace sw::core
 		return std::nullopt;
 	}
 
-	void Entity::addAttack(std::unique_ptr<IAttackStrategy> attack)
+	void Entity::addAttack(std::shared_ptr<const IAttackStrategy> attack)
 	{
 		_attacks.push_back(std::move(attack));
 	}
 
-	auto Entity::attacks() const -> const std::vector<std::unique_ptr<IAttackStrategy>>&
+	auto Entity::attacks() const -> const std::vector<std::shared_ptr<const IAttackStrategy>>&
 	{
 		return _attacks;
 	}
@@ -73,7 +76,26 @@ namespace sw::core
 		return std::nullopt;
 	}
 
-	auto Entity::isAlive() const -> bool
+	auto Entity::clone(const UnitId id, const Position position) const -> std::unique_ptr<Entity>
+	{
+		auto copy = std::make_unique<Entity>(id, position, _typeName);
+		copy->_faction = _faction;
+		copy->_flags = _flags;
+		if (_health)
+		{
+			copy->_health = (*_health)->clone();
+		}
+		// Movement and attacks hold configuration only, so copies share them
+		copy->_movement = _movement;
+		copy->_attacks = _attacks;
+		if (_ai)
+		{
+			copy->_ai = (*_ai)->clone();
+		}
+		return copy;
+	}
+
+	auto Entity::isAliveCustom() const -> bool
 	{
 		if (const auto healthComponent = health())
 		{
@@ -101,6 +101,58 @@ namespace sw::core
 			_position = position;
 		}
 
+		/**
+		 * @brief Get the faction this entity fights for
+		 * @return Faction identifier (NoFaction fights everyone)
+		 */
+		[[nodiscard]]
+		constexpr auto faction() const noexcept -> FactionId
+		{
+			return _faction;
+		}
+
+		/**
+		 * @brief Set the faction this entity fights for
+		 *
+		 * Must be set before the entity is added to a World.
+		 *
+		 * @param faction Faction identifier
+		 */
+		constexpr void setFaction(FactionId faction) noexcept
+		{
+			_faction = faction;
+		}
+
+		/**
+		 * @brief Check whether this entity fights another
+		 * @param other Entity to check
+		 * @return true if the two entities are distinct and hostile factions
+		 */
+		[[nodiscard]]
+		constexpr auto isHostileTo(const Entity& other) const noexcept -> bool
+		{
+			return other._id != _id && areHostile(_faction, other._faction);
+		}
+
+		/**
+		 * @brief Get the index of this entity's row in the World's dense state arrays
+		 * @return Slot index (maintained by World)
+		 */
+		[[nodiscard]]
+		constexpr auto slot() const noexcept -> uint32_t
+		{
+			return _slot;
+		}
+
+		/**
+		 * @brief Set the index of this entity's row in the World's dense state arrays
+		 * @param slot Slot index
+		 */
+		constexpr void setSlot(uint32_t slot) noexcept
+		{
+			_slot = slot;
+		}
+
 		// === Component Management ===
 
 		/**
@@ -118,29 +170,29 @@ namespace sw::core
 
 		/**
 		 * @brief Set the movement strategy component
-		 * @param movement Unique pointer to movement strategy
+		 * @param movement Movement strategy; shared with clones of this entity, so it must be stateless
 		 */
-		void setMovement(std::unique_ptr<IMovementStrategy> movement);
+		void setMovement(std::shared_ptr<const IMovementStrategy> movement);
 
 		/**
 		 * @brief Get the movement strategy component
 		 * @return Optional pointer to movement strategy, or nullopt if not set
 		 */
 		[[nodiscard]]
-		auto movement() const -> std::optional<IMovementStrategy*>;
+		auto movement() const -> std::optional<const IMovementStrategy*>;
 
 		/**
 		 * @brief Add an attack strategy component
-		 * @param attack Unique pointer to attack strategy
+		 * @param attack Attack strategy; shared with clones of this entity, so it must be stateless
 		 */
-		void addAttack(std::unique_ptr<IAttackStrategy> attack);
+		void addAttack(std::shared_ptr<const IAttackStrategy> attack);
 
 		/**
 		 * @brief Get all attack strategy components
 		 * @return Const reference to vector of attack strategies
 		 */
 		[[nodiscard]]
-		auto attacks() const -> const std::vector<std::unique_ptr<IAttackStrategy>>&;
+		auto attacks() const -> const std::vector<std::shared_ptr<const IAttackStrategy>>&;
 
 		/**
 		 * @brief Set the AI strategy component
@@ -155,14 +207,53 @@ namespace sw::core
 		[[nodiscard]]
 		auto ai() const -> std::optional<IAIStrategy*>;
 
+		/**
+		 * @brief Create a copy of this entity with its own identity and position
+		 *
+		 * Health and AI are cloned, so the copy shares no state with this
+		 * entity; the immutable movement and attack strategies are shared
+		 * instead of copied. Used to stamp out many units from one prototype.
+		 *
+		 * @param id Identifier of the copy
+		 * @param position Position of the copy
+		 * @return Newly created entity of the same type and faction
+		 */
+		[[nodiscard]]
+		auto clone(UnitId id, Position position) const -> std::unique_ptr<Entity>;
+
 		// === Behavioral State Inference ===
 
+		/**
+		 * @brief Check whether the health component is anything other than BasicHealthStrategy
+		 *
+		 * Entities without a health component count as custom too. Code that
+		 * tracks HP outside the entity must ask the component for liveness
+		 * when this is set.
+		 *
+		 * @return true if liveness needs the virtual health interface
+		 */
+		[[nodiscard]]
+		constexpr auto hasCustomHealth() const noexcept -> bool
+		{
+			return (_flags & CustomHealthFlag) != 0;
+		}
+
 		/**
 		 * @brief Check if the entity is alive based on health component
+		 *
+		 * Units with BasicHealthStrategy take a non-virtual inline path.
+		 *
 		 * @return true if entity has health component and is alive
 		 */
 		[[nodiscard]]
-		auto isAlive() const -> bool;
+		auto isAlive() const -> bool
+		{
+			if (!hasCustomHealth())
+			{
+				return static_cast<const BasicHealthStrategy&>(**_health).isAlive();
+			}
+			return isAliveCustom();
+		}
 
 		/**
 		 * @brief Check if the entity blocks ground movement
@@ -179,15 +270,27 @@ namespace sw::core
 		constexpr auto canMove() const noexcept -> bool;
 
 	private:
+		static constexpr uint8_t CustomHealthFlag = 1U << 0U;  ///< Health component is not BasicHealthStrategy
+
+		/**
+		 * @brief Liveness through the virtual health interface
+		 * @return true if entity has no health component or its health says it is alive
+		 */
+		[[nodiscard]]
+		auto isAliveCustom() const -> bool;
+
 		// === Core Identity Data ===
-		UnitId _id;				///< Unique identifier for this entity
-		Position _position;		///< Current position on the map
-		std::string _typeName;	///< Human-readable type name
+		UnitId _id;						///< Unique identifier for this entity
+		Position _position;				///< Current position on the map
+		std::string _typeName;			///< Human-readable type name
+		uint32_t _slot{0};				///< Row in the World's dense state arrays
+		FactionId _faction{NoFaction};	///< Team this entity fights for
+		uint8_t _flags;					///< Component traits cached for fast paths
 
 		// === Behavioral Components ===
 		std::optional<std::unique_ptr<IHealthStrategy>> _health;	  ///< Health and vitality management
-		std::optional<std::unique_ptr<IMovementStrategy>> _movement;  ///< Movement capabilities
-		std::vector<std::unique_ptr<IAttackStrategy>> _attacks;		  ///< Available attack methods
+		std::optional<std::shared_ptr<const IMovementStrategy>> _movement;  ///< Movement capabilities
+		std::vector<std::shared_ptr<const IAttackStrategy>> _attacks;		///< Available attack methods
 		std::optional<std::unique_ptr<IAIStrategy>> _ai;			  ///< Autonomous decision-making
 	};
 
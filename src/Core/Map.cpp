@@ -2,7 +2,11 @@
 
 #include "Core/Types.hpp"
 
+#include <algorithm>
 #include <optional>
+#include <span>
+#include <unordered_set>
+#include <vector>
 
 namespace sw::core
 {
@@ -10,9 +14,33 @@ namespace sw::core
 	Map::Map(const Dimensions& dimensions) :
 			_width(dimensions.width),
 			_height(dimensions.height)
-	{}
+	{
+		_index.reset(_width, _height);
+	}
+
+	void Map::reset(const Dimensions& dimensions)
+	{
+		_width = dimensions.width;
+		_height = dimensions.height;
+		_unitPositions.clear();
+		_blockedPositions.clear();
+		_index.reset(_width, _height);
+		_unitFactions.clear();
+		// Faction grids keep their buckets for the next scenario that uses factions
+		_factionCount = 0;
+	}
+
+	void Map::reserve(const size_t additional)
+	{
+		_unitPositions.reserve(_unitPositions.size() + additional);
+		_blockedPositions.reserve(_blockedPositions.size() + additional);
+		if (_factionCount != 0)
+		{
+			_unitFactions.reserve(_unitFactions.size() + additional);
+		}
+	}
 
-	auto Map::placeUnit(const UnitId id, const Position pos, const bool blocksGround) -> bool
+	auto Map::placeUnit(const UnitId id, const Position pos, const bool blocksGround, const FactionId faction) -> bool
 	{
 		if (!isValidPosition(pos))
 		{
@@ -31,7 +59,14 @@ namespace sw::core
 			return false;
 		}
 
+		// Faction indexes first: creating the first one back-fills the units placed so far
+		if (faction != NoFaction || _factionCount != 0)
+		{
+			factionIndex(faction).insert(id, pos);
+			_unitFactions[id] = faction;
+		}
 		_unitPositions[id] = pos;
+		_index.insert(id, pos);
 		if (blocksGround)
 		{
 			_blockedPositions.insert(pos);
@@ -39,16 +74,128 @@ namespace sw::core
 		return true;
 	}
 
+	auto Map::placeUnits(const std::span<const Placement> units) -> bool
+	{
+		std::unordered_set<Position> cells;
+		cells.reserve(units.size());
+		for (const auto& unit : units)
+		{
+			if (!isValidPosition(unit.position) || getUnitAt(unit.position).has_value()
+				|| (unit.blocksGround && blocksAt(unit.position)) || !cells.insert(unit.position).second)
+			{
+				return false;
+			}
+		}
+
+		// Faction indexes first: creating the first one back-fills the units placed so far
+		const bool useFactions = _factionCount != 0
+							  || std::ranges::any_of(units, [](const Placement& unit) { return unit.faction != NoFaction; });
+		if (useFactions)
+		{
+			for (const auto& unit : units)
+			{
+				factionIndex(unit.faction);
+			}
+		}
+		reserve(units.size());
+
+		std::vector<SpatialIndex::Entry> entries;
+		entries.reserve(units.size());
+		for (const auto& unit : units)
+		{
+			_unitPositions[unit.id] = unit.position;
+			if (unit.blocksGround)
+			{
+				_blockedPositions.insert(unit.position);
+			}
+			if (useFactions)
+			{
+				_unitFactions[unit.id] = unit.faction;
+			}
+			entries.push_back({.id = unit.id, .position = unit.position});
+		}
+
+		_index.insertBatch(entries);
+		if (useFactions)
+		{
+			std::vector<SpatialIndex::Entry> members;
+			for (auto& [faction, index] : std::span(_factions).first(_factionCount))
+			{
+				members.clear();
+				for (size_t i = 0; i < units.size(); ++i)
+				{
+					if (units[i].faction == faction)
+					{
+						members.push_back(entries[i]);
+					}
+				}
+				index.insertBatch(members);
+			}
+		}
+		return true;
+	}
+
 	void Map::removeUnit(const UnitId id)
 	{
 		auto it = _unitPositions.find(id);
 		if (it != _unitPositions.end())
 		{
 			_blockedPositions.erase(it->second);
+			_index.remove(id, it->second);
+			if (auto* index = factionIndexOf(id))
+			{
+				index->remove(id, it->second);
+				_unitFactions.erase(id);
+			}
 			_unitPositions.erase(it);
 		}
 	}
 
+	void Map::removeUnits(const std::span<const SpatialIndex::Entry> units)
+	{
+		if (units.empty())
+		{
+			return;
+		}
+
+		for (const auto& unit : units)
+		{
+			_blockedPositions.erase(unit.position);
+			_unitPositions.erase(unit.id);
+		}
+		_index.removeBatch(units);
+		if (_factionCount == 0)
+		{
+			return;
+		}
+
+		std::vector<FactionId> factions;
+		factions.reserve(units.size());
+		for (const auto& unit : units)
+		{
+			const auto it = _unitFactions.find(unit.id);
+			factions.push_back(it != _unitFactions.end() ? it->second : NoFaction);
+			if (it != _unitFactions.end())
+			{
+				_unitFactions.erase(it);
+			}
+		}
+
+		std::vector<SpatialIndex::Entry> members;
+		for (auto& [faction, index] : std::span(_factions).first(_factionCount))
+		{
+			members.clear();
+			for (size_t i = 0; i < units.size(); ++i)
+			{
+				if (factions[i] == faction)
+				{
+					members.push_back(units[i]);
+				}
+			}
+			index.removeBatch(members);
+		}
+	}
+
 	auto Map::moveUnit(const UnitId id, const Position newPos) -> bool
 	{
 		auto it = _unitPositions.find(id);
@@ -71,7 +218,12 @@ namespace sw::core
 
 		const Position oldPos = it->second;
 		_blockedPositions.erase(oldPos);
-		_unitPositions[id] = newPos;
+		it->second = newPos;
+		_index.move(id, oldPos, newPos);
+		if (auto* index = factionIndexOf(id))
+		{
+			index->move(id, oldPos, newPos);
+		}
 		// Note: We don't automatically add to _blockedPositions here because
 		// we don't have access to the unit's blocksGround() property in this context.
 		// The caller (World::tryMove) should handle this properly.
@@ -91,14 +243,57 @@ namespace sw::core
 
 	auto Map::getUnitAt(const Position pos) const -> std::optional<UnitId>
 	{
-		for (const auto& [id, position] : _unitPositions)
+		return _index.unitAt(pos);
+	}
+
+	auto Map::factionIndex(const FactionId faction) -> SpatialIndex&
+	{
+		const auto active = std::span(_factions).first(_factionCount);
+		const auto it = std::ranges::find(active, faction, &std::pair<FactionId, SpatialIndex>::first);
+		if (it != active.end())
+		{
+			return it->second;
+		}
+
+		auto activate = [this](const FactionId id) -> SpatialIndex&
+		{
+			if (_factionCount == _factions.size())
+			{
+				_factions.emplace_back();
+			}
+			auto& [slotFaction, index] = _factions[_factionCount++];
+			slotFaction = id;
+			index.reset(_width, _height);
+			return index;
+		};
+
+		if (_factionCount == 0)
 		{
-			if (position == pos)
+			// First faction seen: everything placed so far fights for no one
+			auto& unaligned = activate(NoFaction);
+			for (const auto& [id, position] : _unitPositions)
+			{
+				_unitFactions[id] = NoFaction;
+				unaligned.insert(id, position);
+			}
+			if (faction == NoFaction)
 			{
-				return id;
+				return unaligned;
 			}
 		}
-		return std::nullopt;
+
+		return activate(faction);
+	}
+
+	auto Map::factionIndexOf(const UnitId id) -> SpatialIndex*
+	{
+		if (_factionCount == 0)
+		{
+			return nullptr;
+		}
+
+		const auto it = _unitFactions.find(id);
+		return it != _unitFactions.end() ? &factionIndex(it->second) : nullptr;
 	}
 
 	void Map::setPositionBlocked(Position pos, bool blocked)
@@ -12,15 +12,22 @@
  * - Unit position tracking and management
  * - Collision detection and ground blocking
  * - Movement validation and pathfinding support
+ * - Per-faction spatial indexes for hostile-unit queries
  */
 
 #pragma once
 
+#include "SpatialIndex.hpp"
 #include "Types.hpp"
 
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace sw::core
 {
@@ -39,8 +46,10 @@ namespace sw::core
 	 * - Ground blocking system for collision detection
 	 * - Spatial validation and boundary checking
 	 *
-	 * The map uses efficient data structures (unordered_map, unordered_set) for
-	 * fast spatial queries and collision detection during simulation updates.
+	 * The map uses hashed lookups for per-unit queries and a bucket grid
+	 * (SpatialIndex) for cell and neighbourhood queries. Once a unit with a
+	 * faction is placed, every faction also gets its own bucket grid, so
+	 * hostile-unit queries skip the querying unit's allies entirely.
 	 */
 	class Map
 	{
@@ -65,16 +74,66 @@ namespace sw::core
 		 */
 		explicit Map(const Dimensions& dimensions);
 
+		/**
+		 * @brief Clear all units and resize the map, keeping container capacity
+		 *
+		 * Used when a World is reused for a new scenario so lookup tables stay warm.
+		 *
+		 * @param dimensions New map dimensions
+		 */
+		void reset(const Dimensions& dimensions);
+
+		/**
+		 * @brief Get the map dimensions
+		 * @return Width and height of the map in grid units
+		 */
+		[[nodiscard]]
+		constexpr auto dimensions() const noexcept -> Dimensions
+		{
+			return {.width = _width, .height = _height};
+		}
+
 		// === Unit Management ===
 
+		/**
+		 * @brief Make room for more units without rehashing while they are placed
+		 * @param additional Number of units about to be placed
+		 */
+		void reserve(size_t additional);
+
 		/**
 		 * @brief Place a unit at the specified position
 		 * @param id Unit identifier
 		 * @param pos Position to place the unit
 		 * @param blocksGround Whether the unit blocks ground movement
+		 * @param faction Faction the unit fights for
 		 * @return true if placement was successful, false if position is invalid or occupied
 		 */
-		auto placeUnit(UnitId id, Position pos, bool blocksGround) -> bool;
+		auto placeUnit(UnitId id, Position pos, bool blocksGround, FactionId faction = NoFaction) -> bool;
+
+		/**
+		 * @brief Unit to place with placeUnits()
+		 */
+		struct Placement
+		{
+			UnitId id;				   ///< Unit identifier
+			Position position;		   ///< Cell to place the unit on
+			bool blocksGround;		   ///< Whether the unit blocks ground movement
+			FactionId faction{NoFaction};  ///< Faction the unit fights for
+		};
+
+		/**
+		 * @brief Place many units at once
+		 *
+		 * Every placement is validated before anything changes. The units are
+		 * then recorded and the spatial indexes are filled in one batch per
+		 * index, instead of one update per unit.
+		 *
+		 * @param units Units to place
+		 * @return true if all units were placed; false (nothing placed) if a position is
+		 *         invalid, occupied or used twice in the batch
+		 */
+		auto placeUnits(std::span<const Placement> units) -> bool;
 
 		/**
 		 * @brief Remove a unit from the map
@@ -82,6 +141,16 @@ namespace sw::core
 		 */
 		void removeUnit(UnitId id);
 
+		/**
+		 * @brief Remove many units at once
+		 *
+		 * The positions come from the caller, so units are not looked up one by
+		 * one, and each spatial index is updated in a single batch.
+		 *
+		 * @param units Units to remove, with the cells they occupy
+		 */
+		void removeUnits(std::span<const SpatialIndex::Entry> units);
+
 		/**
 		 * @brief Move a unit to a new position
 		 * @param id Unit identifier
@@ -128,6 +197,110 @@ namespace sw::core
 		[[nodiscard]]
 		auto getUnitAt(Position pos) const -> std::optional<UnitId>;
 
+		/**
+		 * @brief Visit every unit within a Chebyshev radius of a position
+		 *
+		 * Backed by the bucket grid, so only cells near the query are examined.
+		 *
+		 * @param center Query centre
+		 * @param radius Maximum distance (inclusive)
+		 * @param visitor Callable taking `const SpatialIndex::Entry&`
+		 */
+		template <class TVisitor>
+		void forEachUnitInRange(Position center, uint32_t radius, TVisitor&& visitor) const
+		{
+			_index.forEachInRange(center, radius, std::forward<TVisitor>(visitor));
+		}
+
+		/**
+		 * @brief Visit every unit within a radius that is hostile to a faction
+		 *
+		 * Only the bucket grids of opposing factions are examined. The querying
+		 * unit itself may be visited and must be skipped by the caller.
+		 *
+		 * @param center Query centre
+		 * @param radius Maximum distance (inclusive)
+		 * @param faction Faction of the querying unit
+		 * @param visitor Callable taking `const SpatialIndex::Entry&`
+		 */
+		template <class TVisitor>
+		void forEachHostileInRange(Position center, uint32_t radius, FactionId faction, TVisitor&& visitor) const
+		{
+			if (_factionCount == 0 || faction == NoFaction)
+			{
+				_index.forEachInRange(center, radius, visitor);
+				return;
+			}
+
+			for (const auto& [id, index] : activeFactions())
+			{
+				if (areHostile(faction, id))
+				{
+					index.forEachInRange(center, radius, visitor);
+				}
+			}
+		}
+
+		/**
+		 * @brief Collect the accepted units hostile to a faction that lie nearest to a position
+		 * @param center Query centre
+		 * @param faction Faction of the searching unit
+		 * @param accept Predicate taking `const SpatialIndex::Entry&`
+		 * @param nearest Receives the entries at the smallest distance
+		 */
+		template <class TAccept>
+		void collectNearestHostile(
+			Position center, FactionId faction, TAccept&& accept, std::vector<SpatialIndex::Entry>& nearest) const
+		{
+			uint32_t bestDist = std::numeric_limits<uint32_t>::max();
+			if (_factionCount == 0 || faction == NoFaction)
+			{
+				_index.collectNearest(center, accept, nearest, bestDist);
+				return;
+			}
+
+			for (const auto& [id, index] : activeFactions())
+			{
+				if (areHostile(faction, id))
+				{
+					index.collectNearest(center, accept, nearest, bestDist);
+				}
+			}
+		}
+
+		/**
+		 * @brief Check whether any placed unit has ever belonged to a faction
+		 * @return true once a unit with a faction other than NoFaction was placed
+		 */
+		[[nodiscard]]
+		auto hasFactions() const noexcept -> bool
+		{
+			return _factionCount != 0;
+		}
+
+		/**
+		 * @brief Get the stamp of the most recent unit placement, move or removal
+		 * @return Monotonic change counter
+		 */
+		[[nodiscard]]
+		auto changeStamp() const noexcept -> uint64_t
+		{
+			return _index.changeStamp();
+		}
+
+		/**
+		 * @brief Check whether units were placed, moved or removed near a position
+		 * @param center Query centre
+		 * @param radius Chebyshev radius of the region
+		 * @param stamp Stamp obtained from changeStamp() earlier
+		 * @return true if the region may have changed since the stamp (conservative)
+		 */
+		[[nodiscard]]
+		auto changedSince(Position center, uint32_t radius, uint64_t stamp) const -> bool
+		{
+			return _index.changedSince(center, radius, stamp);
+		}
+
 		/**
 		 * @brief Set whether a position is blocked for ground movement
 		 * @param pos Position to set blocking status for
@@ -136,10 +309,43 @@ namespace sw::core
 		void setPositionBlocked(Position pos, bool blocked);
 
 	private:
-		uint32_t _width{0};									  ///< Map width in grid units
-		uint32_t _height{0};								  ///< Map height in grid units
-		std::unordered_map<UnitId, Position> _unitPositions;  ///< Mapping from unit ID to position
-		std::unordered_set<Position> _blockedPositions;		  ///< Set of positions blocked by units
+		uint32_t _width{0};											///< Map width in grid units
+		uint32_t _height{0};										///< Map height in grid units
+		std::unordered_map<UnitId, Position> _unitPositions;		///< Mapping from unit ID to position
+		std::unordered_set<Position> _blockedPositions;				///< Set of positions blocked by units
+		SpatialIndex _index;										///< Bucket grid for neighbourhood queries
+		std::unordered_map<UnitId, FactionId> _unitFactions;		///< Faction of each unit once factions are in use
+		std::vector<std::pair<FactionId, SpatialIndex>> _factions;	///< Bucket grid per faction, kept across resets
+		size_t _factionCount{0};									///< Leading entries of _factions in use
+
+		/**
+		 * @brief Get the bucket grids of the factions in use
+		 * @return Faction and grid pairs, NoFaction first
+		 */
+		[[nodiscard]]
+		auto activeFactions() const noexcept -> std::span<const std::pair<FactionId, SpatialIndex>>
+		{
+			return std::span(_factions).first(_factionCount);
+		}
+
+		/**
+		 * @brief Get the bucket grid of a faction, creating it if needed
+		 *
+		 * The first call also creates the NoFaction grid and fills it with
+		 * every unit placed so far. Grids left over from before a reset are
+		 * reset in place and reused before new ones are allocated.
+		 *
+		 * @param faction Faction identifier
+		 * @return Reference to the faction's bucket grid
+		 */
+		auto factionIndex(FactionId faction) -> SpatialIndex&;
+
+		/**
+		 * @brief Get the bucket grid holding a placed unit, if factions are in use
+		 * @param id Unit identifier
+		 * @return Pointer to the grid, or nullptr while no factions are in use
+		 */
+		auto factionIndexOf(UnitId id) -> SpatialIndex*;
 	};
 
 }
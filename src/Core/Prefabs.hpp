@@ -12,6 +12,7 @@
  * - Strategy component assembly
  * - Unit type standardization
  * - Factory pattern implementation for unit creation
+ * - Lookup of the built-in prefabs by type name
  */
 
 #pragma once
@@ -23,7 +24,12 @@
 #include "Strategies/HealthStrategies.hpp"
 #include "Strategies/MovementStrategies.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <memory>
+#include <span>
+#include <string_view>
 
 namespace sw::core
 {
@@ -54,6 +60,18 @@ namespace sw::core
 		RangeValue range;
 	};
 
+	/**
+	 * @brief Configuration struct for grenadier unit creation
+	 */
+	struct GrenadierConfig
+	{
+		HealthPoints hp;
+		StrengthValue strength;
+		PowerValue power;
+		RangeValue range;
+		RangeValue radius;
+	};
+
 	/**
 	 * @brief Create a swordsman unit with predefined configuration
 	 *
@@ -114,4 +132,82 @@ namespace sw::core
 		return entity;
 	}
 
+	/**
+	 * @brief Create a grenadier unit with predefined configuration
+	 *
+	 * Grenadiers lob bombs that damage every hostile unit around the cell they
+	 * land on, and fall back to a melee attack when an enemy is adjacent.
+	 *
+	 * Configuration:
+	 * - Health: Basic health system with specified HP
+	 * - Movement: 1-square terrain movement
+	 * - Combat: Splash attack (power-based) and melee attack (strength-based)
+	 *   - Splash attack is aimed at a target 2 to range squares away
+	 * - AI: Hunter AI, trying the splash attack before the melee attack
+	 *
+	 * @param id Unique identifier for the unit
+	 * @param pos Initial position on the map
+	 * @param config Grenadier configuration containing hp, strength, power, range and splash radius
+	 * @return Unique pointer to the created grenadier entity
+	 */
+	inline auto makeGrenadier(UnitId id, Position pos, const GrenadierConfig& config) noexcept
+		-> std::unique_ptr<Entity>
+	{
+		auto entity = std::make_unique<Entity>(id, pos, "Grenadier");
+		entity->setHealth(createBasicHealth(config.hp));
+		entity->setMovement(createTerrainMovement(static_cast<RangeValue>(1)));
+		entity->addAttack(createSplashAttack(
+			static_cast<DamageValue>(config.power), static_cast<RangeValue>(2), config.range, config.radius));
+		entity->addAttack(createMeleeAttack(static_cast<DamageValue>(config.strength)));
+		entity->setAI(sw::core::createHunterAI());
+		return entity;
+	}
+
+	/**
+	 * @brief Built-in prefab that can be created by name from a list of stats
+	 */
+	struct PrefabType
+	{
+		using Factory = auto (*)(UnitId id, Position pos, std::span<const uint32_t> stats) -> std::unique_ptr<Entity>;
+
+		std::string_view name;	///< Type name reported in events
+		size_t statCount;		///< Number of stats, in the order the SPAWN_<TYPE> command takes them
+		Factory make;			///< Creates a unit from exactly statCount stats
+	};
+
+	/**
+	 * @brief Every built-in prefab, addressable by type name
+	 */
+	inline constexpr std::array<PrefabType, 3> PrefabTypes = {{
+		{.name = "Swordsman",
+		 .statCount = 2,
+		 .make = [](UnitId id, Position pos, std::span<const uint32_t> stats)
+		 { return makeSwordsman(id, pos, {.hp = stats[0], .strength = stats[1]}); }},
+		{.name = "Hunter",
+		 .statCount = 4,
+		 .make = [](UnitId id, Position pos, std::span<const uint32_t> stats)
+		 { return makeHunter(id, pos, {.hp = stats[0], .agility = stats[1], .strength = stats[2], .range = stats[3]}); }},
+		{.name = "Grenadier",
+		 .statCount = 5,
+		 .make = [](UnitId id, Position pos, std::span<const uint32_t> stats)
+		 {
+			 return makeGrenadier(
+				 id,
+				 pos,
+				 {.hp = stats[0], .strength = stats[1], .power = stats[2], .range = stats[3], .radius = stats[4]});
+		 }},
+	}};
+
+	/**
+	 * @brief Find a built-in prefab by type name
+	 * @param typeName Type name as reported in events
+	 * @return Prefab description, or nullptr if the name is not a built-in type
+	 */
+	[[nodiscard]]
+	constexpr auto findPrefabType(std::string_view typeName) noexcept -> const PrefabType*
+	{
+		const auto* it = std::ranges::find(PrefabTypes, typeName, &PrefabType::name);
+		return it != PrefabTypes.end() ? it : nullptr;
+	}
+
 }
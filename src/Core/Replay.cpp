@@ -0,0 +1,443 @@
+#include "Replay.hpp"
+
+#include "IO/System/BinaryStream.hpp"
+#include "IO/System/details/Varint.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+namespace sw::core
+{
+	namespace
+	{
+		constexpr uint32_t ReplayMagic = 0x50525753;  // "SWRP"
+		constexpr uint32_t ReplayVersion = 1;
+		constexpr size_t HeaderSize = 8;
+		constexpr size_t TrailerSize = 12;
+		constexpr size_t FooterFieldsSize = 16;
+
+		enum class FrameKind : uint8_t
+		{
+			Keyframe,
+			Delta
+		};
+
+		using io::details::putVarint;
+		using io::details::zigzag;
+
+		// Ids listed in turn order are mostly increasing, so each is stored relative to the previous one
+		void putIdDelta(std::string& out, UnitId& previous, const UnitId id)
+		{
+			putVarint(out, zigzag(int64_t{id} - previous));
+			previous = id;
+		}
+
+		auto readIdDelta(io::details::VarintReader& reader, UnitId& previous) -> UnitId
+		{
+			previous = static_cast<UnitId>(previous + reader.nextSigned());
+			return previous;
+		}
+
+		[[noreturn]]
+		void corrupt(const std::string& reason)
+		{
+			throw std::runtime_error("Corrupt replay file: " + reason);
+		}
+
+		// Mirror of ReplayWriter::encodeUnits
+		void decodeUnits(io::details::VarintReader& reader, std::vector<ReplayUnit>& units)
+		{
+			std::vector<std::string> types(reader.next());
+			for (auto& type : types)
+			{
+				type = reader.text();
+			}
+
+			const auto count = reader.next();
+			UnitId id = 0;
+			for (uint64_t i = 0; i < count; ++i)
+			{
+				ReplayUnit unit;
+				unit.id = readIdDelta(reader, id);
+				const auto type = reader.next();
+				if (type >= types.size())
+				{
+					corrupt("unit type index out of range");
+				}
+				unit.type = types[type];
+				unit.position.x = static_cast<uint32_t>(reader.next());
+				unit.position.y = static_cast<uint32_t>(reader.next());
+				unit.hp = static_cast<HealthPoints>(reader.next());
+				unit.faction = static_cast<FactionId>(reader.next());
+				units.push_back(std::move(unit));
+			}
+		}
+	}
+
+	ReplayWriter::ReplayWriter(const std::filesystem::path& path, const uint32_t keyframeInterval) :
+			_file(path, std::ios::binary | std::ios::trunc),
+			_path(path),
+			_interval(std::max(keyframeInterval, 1U))
+	{
+		if (!_file)
+		{
+			throw std::runtime_error("Failed to open replay file for writing: " + path.string());
+		}
+		io::BinaryWriter writer(_file);
+		writer.write(ReplayMagic);
+		writer.write(ReplayVersion);
+	}
+
+	ReplayWriter::~ReplayWriter()
+	{
+		try
+		{
+			close();
+		}
+		catch (const std::exception&)
+		{
+			// Destructors must not throw; call close() to see write errors
+		}
+	}
+
+	void ReplayWriter::record(const TurnNumber turn, const std::span<const UnitState> units)
+	{
+		if (_recorded && turn <= _lastTurn)
+		{
+			throw std::invalid_argument("Replay turns must increase");
+		}
+
+		const bool keyframe = !_recorded || turn / _interval != _lastTurn / _interval;
+		_payload.clear();
+		if (keyframe)
+		{
+			if (_recorded)
+			{
+				// Windows without a recorded turn point at the last keyframe before them
+				_keyframes.resize((turn / _interval) - (_firstTurn / _interval), _keyframes.back());
+			}
+			else
+			{
+				_firstTurn = turn;
+			}
+			_keyframes.push_back(static_cast<uint64_t>(_file.tellp()));
+			encodeUnits(units);
+			track(units);
+		}
+		else
+		{
+			encodeDelta(units);
+		}
+
+		std::string header;
+		header.push_back(static_cast<char>(keyframe ? FrameKind::Keyframe : FrameKind::Delta));
+		putVarint(header, turn);
+		putVarint(header, _payload.size());
+		io::BinaryWriter writer(_file);
+		writer.writeBytes(header.data(), header.size());
+		writer.writeBytes(_payload.data(), _payload.size());
+
+		_recorded = true;
+		_lastTurn = turn;
+	}
+
+	void ReplayWriter::encodeUnits(const std::span<const UnitState> units)
+	{
+		// Few distinct types per battle: a linear table beats hashing every unit
+		std::vector<std::string_view> types;
+		std::string rows;
+		UnitId id = 0;
+		for (const UnitState& unit : units)
+		{
+			auto type = std::ranges::find(types, unit.type);
+			if (type == types.end())
+			{
+				types.push_back(unit.type);
+				type = types.end() - 1;
+			}
+			putIdDelta(rows, id, unit.id);
+			putVarint(rows, static_cast<uint64_t>(type - types.begin()));
+			putVarint(rows, unit.x);
+			putVarint(rows, unit.y);
+			putVarint(rows, unit.hp);
+			putVarint(rows, unit.faction);
+		}
+
+		putVarint(_payload, types.size());
+		for (const auto type : types)
+		{
+			putVarint(_payload, type.size());
+			_payload.append(type);
+		}
+		putVarint(_payload, units.size());
+		_payload.append(rows);
+	}
+
+	void ReplayWriter::encodeDelta(const std::span<const UnitState> units)
+	{
+		std::vector<UnitState> spawned;
+		std::string moves;
+		std::string hits;
+		std::string deaths;
+		uint64_t moveCount = 0;
+		uint64_t hitCount = 0;
+		uint64_t deathCount = 0;
+		UnitId moveId = 0;
+		UnitId hitId = 0;
+		UnitId deathId = 0;
+
+		for (const UnitState& unit : units)
+		{
+			const auto it = _previous.find(unit.id);
+			if (it == _previous.end())
+			{
+				spawned.push_back(unit);
+				continue;
+			}
+
+			Tracked& tracked = it->second;
+			tracked.seen = true;
+			if (tracked.position.x != unit.x || tracked.position.y != unit.y)
+			{
+				++moveCount;
+				putIdDelta(moves, moveId, unit.id);
+				putVarint(moves, zigzag(int64_t{unit.x} - tracked.position.x));
+				putVarint(moves, zigzag(int64_t{unit.y} - tracked.position.y));
+				tracked.position = {.x = unit.x, .y = unit.y};
+			}
+			if (tracked.hp != unit.hp)
+			{
+				++hitCount;
+				putIdDelta(hits, hitId, unit.id);
+				putVarint(hits, unit.hp);
+				tracked.hp = unit.hp;
+			}
+		}
+
+		// Units of the last frame that were not seen have died; the survivors keep their order
+		std::erase_if(
+			_order,
+			[&](const UnitId id)
+			{
+				const auto it = _previous.find(id);
+				if (it->second.seen)
+				{
+					it->second.seen = false;
+					return false;
+				}
+				++deathCount;
+				putIdDelta(deaths, deathId, id);
+				_previous.erase(it);
+				return true;
+			});
+		for (const UnitState& unit : spawned)
+		{
+			_order.push_back(unit.id);
+			_previous.emplace(unit.id, Tracked{.position = {.x = unit.x, .y = unit.y}, .hp = unit.hp});
+		}
+
+		encodeUnits(spawned);
+		putVarint(_payload, moveCount);
+		_payload.append(moves);
+		putVarint(_payload, hitCount);
+		_payload.append(hits);
+		putVarint(_payload, deathCount);
+		_payload.append(deaths);
+	}
+
+	void ReplayWriter::track(const std::span<const UnitState> units)
+	{
+		_order.clear();
+		_previous.clear();
+		_order.reserve(units.size());
+		_previous.reserve(units.size());
+		for (const UnitState& unit : units)
+		{
+			_order.push_back(unit.id);
+			_previous.emplace(unit.id, Tracked{.position = {.x = unit.x, .y = unit.y}, .hp = unit.hp});
+		}
+	}
+
+	void ReplayWriter::close()
+	{
+		if (_closed)
+		{
+			return;
+		}
+		_closed = true;
+
+		const auto footerOffset = static_cast<uint64_t>(_file.tellp());
+		io::BinaryWriter writer(_file);
+		writer.write(_interval);
+		writer.write(_firstTurn);
+		writer.write(_lastTurn);
+		writer.write(static_cast<uint32_t>(_keyframes.size()));
+		for (const uint64_t offset : _keyframes)
+		{
+			writer.write(offset);
+		}
+		writer.write(footerOffset);
+		writer.write(ReplayMagic);
+
+		_file.close();
+		if (!_file)
+		{
+			throw std::runtime_error("Failed to write replay file: " + _path.string());
+		}
+	}
+
+	ReplayReader::ReplayReader(const std::filesystem::path& path) :
+			_file(path)
+	{
+		using io::loadLittleEndian;
+		const auto bytes = _file.bytes();
+		if (bytes.size() < HeaderSize + TrailerSize + FooterFieldsSize || loadLittleEndian<uint32_t>(bytes, 0) != ReplayMagic
+			|| loadLittleEndian<uint32_t>(bytes, bytes.size() - 4) != ReplayMagic)
+		{
+			throw std::runtime_error("Not a replay file: " + path.string());
+		}
+		if (const auto version = loadLittleEndian<uint32_t>(bytes, 4); version != ReplayVersion)
+		{
+			throw std::runtime_error("Unsupported replay version " + std::to_string(version));
+		}
+
+		const auto footer = loadLittleEndian<uint64_t>(bytes, bytes.size() - TrailerSize);
+		if (footer < HeaderSize || footer > bytes.size() - TrailerSize - FooterFieldsSize)
+		{
+			corrupt("footer offset out of range");
+		}
+		_framesEnd = footer;
+		_interval = loadLittleEndian<uint32_t>(bytes, footer);
+		_firstTurn = loadLittleEndian<TurnNumber>(bytes, footer + 4);
+		_lastTurn = loadLittleEndian<TurnNumber>(bytes, footer + 8);
+		const auto windows = loadLittleEndian<uint32_t>(bytes, footer + 12);
+		if (_interval == 0 || windows == 0 || windows > (bytes.size() - TrailerSize - footer - FooterFieldsSize) / 8
+			|| windows != (_lastTurn / _interval) - (_firstTurn / _interval) + 1)
+		{
+			corrupt("bad keyframe index");
+		}
+
+		_keyframes.reserve(windows);
+		for (uint32_t i = 0; i < windows; ++i)
+		{
+			const auto offset = loadLittleEndian<uint64_t>(bytes, footer + FooterFieldsSize + (8 * size_t{i}));
+			if (offset < HeaderSize || offset >= _framesEnd)
+			{
+				corrupt("keyframe offset out of range");
+			}
+			_keyframes.push_back(offset);
+		}
+	}
+
+	auto ReplayReader::stateAt(TurnNumber turn) const -> std::vector<ReplayUnit>
+	{
+		if (turn < _firstTurn)
+		{
+			throw std::out_of_range(
+				"Turn " + std::to_string(turn) + " precedes the replay's first turn " + std::to_string(_firstTurn));
+		}
+		turn = std::min(turn, _lastTurn);
+
+		const auto frames = _file.bytes().subspan(0, _framesEnd);
+		const auto keyframeTurn = [&frames](const uint64_t offset) -> TurnNumber
+		{
+			io::details::VarintReader header(frames.subspan(offset));
+			header.byte();
+			return static_cast<TurnNumber>(header.next());
+		};
+
+		// A window's keyframe is its first recorded turn; earlier turns of the window still belong to the
+		// previous window's frames. The first window always starts with the first recorded turn.
+		size_t window = (turn / _interval) - (_firstTurn / _interval);
+		if (window > 0 && keyframeTurn(_keyframes[window]) > turn)
+		{
+			--window;
+		}
+
+		io::details::VarintReader reader(frames.subspan(_keyframes[window]));
+		std::vector<ReplayUnit> units;
+		std::vector<uint8_t> removed;	// Per-slot death marks, compacted once at the end
+		std::unordered_map<UnitId, size_t> slots;
+		const auto unitAt = [&](const UnitId id) -> size_t
+		{
+			const auto it = slots.find(id);
+			if (it == slots.end())
+			{
+				corrupt("delta refers to unknown unit " + std::to_string(id));
+			}
+			return it->second;
+		};
+
+		bool first = true;
+		while (!reader.atEnd())
+		{
+			const auto kind = static_cast<FrameKind>(reader.byte());
+			const auto frameTurn = static_cast<TurnNumber>(reader.next());
+			io::details::VarintReader payload(reader.take(reader.next()));
+			if (first != (kind == FrameKind::Keyframe))
+			{
+				if (first)
+				{
+					corrupt("keyframe index does not point at a keyframe");
+				}
+				break;
+			}
+			if (frameTurn > turn)
+			{
+				break;
+			}
+			first = false;
+
+			// Keyframes and the spawns of a delta share one encoding; either way new units are appended
+			const size_t known = units.size();
+			decodeUnits(payload, units);
+			removed.resize(units.size(), 0);
+			slots.reserve(units.size());
+			for (size_t slot = known; slot < units.size(); ++slot)
+			{
+				slots.insert_or_assign(units[slot].id, slot);
+			}
+			if (kind == FrameKind::Keyframe)
+			{
+				continue;
+			}
+
+			UnitId id = 0;
+			for (auto count = payload.next(); count > 0; --count)
+			{
+				ReplayUnit& unit = units[unitAt(readIdDelta(payload, id))];
+				unit.position.x = static_cast<uint32_t>(unit.position.x + payload.nextSigned());
+				unit.position.y = static_cast<uint32_t>(unit.position.y + payload.nextSigned());
+			}
+			id = 0;
+			for (auto count = payload.next(); count > 0; --count)
+			{
+				ReplayUnit& unit = units[unitAt(readIdDelta(payload, id))];
+				unit.hp = static_cast<HealthPoints>(payload.next());
+			}
+			id = 0;
+			for (auto count = payload.next(); count > 0; --count)
+			{
+				const UnitId dead = readIdDelta(payload, id);
+				removed[unitAt(dead)] = 1;
+				slots.erase(dead);
+			}
+		}
+
+		size_t kept = 0;
+		for (size_t slot = 0; slot < units.size(); ++slot)
+		{
+			if (removed[slot] == 0)
+			{
+				if (kept != slot)
+				{
+					units[kept] = std::move(units[slot]);
+				}
+				++kept;
+			}
+		}
+		units.resize(kept);
+		return units;
+	}
+}
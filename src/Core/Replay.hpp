@@ -0,0 +1,182 @@
+/**
+ * @file Replay.hpp
+ * @brief Seekable replay files: periodic world keyframes with per-turn deltas in between.
+ *
+ * A replay records the battlefield at the end of every turn. Turns are grouped
+ * into windows of K turns; the first recorded turn of each window is stored as
+ * a keyframe (every unit with its type, position, HP and faction) and the rest
+ * as deltas against the previous turn (spawns, moves, HP changes, deaths). A
+ * footer maps each window to its keyframe, so rebuilding the state at any turn
+ * reads one keyframe and applies fewer than K deltas.
+ *
+ * Key responsibilities:
+ * - Diffing consecutive unit state views into compact varint-coded deltas
+ * - Keyframe placement and the window-to-keyframe footer index
+ * - Memory-mapped random access reconstruction of the state at a turn
+ */
+
+#pragma once
+
+#include "Core/Types.hpp"
+#include "IO/System/MappedFile.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sw::core
+{
+
+	/**
+	 * @brief One unit of a reconstructed replay frame
+	 */
+	struct ReplayUnit
+	{
+		UnitId id{};
+		std::string type;
+		Position position;
+		HealthPoints hp{};
+		FactionId faction{NoFaction};
+	};
+
+	/**
+	 * @brief Records end-of-turn world states into a replay file
+	 */
+	class ReplayWriter
+	{
+	public:
+		/**
+		 * @brief Create a replay file
+		 * @param path Destination file (replaced)
+		 * @param keyframeInterval Turns per keyframe window (K)
+		 * @throws std::runtime_error if the file cannot be created
+		 */
+		explicit ReplayWriter(const std::filesystem::path& path, uint32_t keyframeInterval = 64);
+
+		~ReplayWriter();
+		ReplayWriter(const ReplayWriter&) = delete;
+		auto operator=(const ReplayWriter&) -> ReplayWriter& = delete;
+
+		/**
+		 * @brief Record the world state at the end of a turn
+		 *
+		 * Turns must increase from call to call; turns without a record keep the
+		 * state of the last recorded one.
+		 *
+		 * @param turn Turn the state belongs to
+		 * @param units Every unit in turn order, e.g. Simulation::unitStates()
+		 * @throws std::invalid_argument if the turn does not follow the previous one
+		 */
+		void record(TurnNumber turn, std::span<const UnitState> units);
+
+		/**
+		 * @brief Write the footer index and close the file
+		 *
+		 * Done by the destructor as well, which cannot report errors.
+		 *
+		 * @throws std::runtime_error on I/O failure
+		 */
+		void close();
+
+	private:
+		/**
+		 * @brief Last recorded state of a unit, for diffing
+		 */
+		struct Tracked
+		{
+			Position position;
+			HealthPoints hp{};
+			bool seen = false;	///< Still present in the state being recorded
+		};
+
+		std::ofstream _file;							  ///< Output stream
+		std::filesystem::path _path;					  ///< File name for error messages
+		uint32_t _interval;								  ///< Turns per keyframe window
+		std::vector<uint64_t> _keyframes;				  ///< Keyframe offset of each window since the first
+		bool _recorded = false;							  ///< Whether any frame was written
+		TurnNumber _firstTurn{0};						  ///< Turn of the first frame
+		TurnNumber _lastTurn{0};						  ///< Turn of the last frame
+		std::vector<UnitId> _order;						  ///< Units of the last frame in turn order
+		std::unordered_map<UnitId, Tracked> _previous;	  ///< Units of the last frame by id
+		std::string _payload;							  ///< Reused frame encoding buffer
+		bool _closed = false;							  ///< Whether the footer was written
+
+		/**
+		 * @brief Encode the units' full state, with a table of their type names
+		 * @param units Units to encode
+		 */
+		void encodeUnits(std::span<const UnitState> units);
+
+		/**
+		 * @brief Encode the changes since the last frame and update the tracked state
+		 * @param units State being recorded
+		 */
+		void encodeDelta(std::span<const UnitState> units);
+
+		/**
+		 * @brief Replace the tracked state without diffing
+		 * @param units State being recorded
+		 */
+		void track(std::span<const UnitState> units);
+	};
+
+	/**
+	 * @brief Random-access reader over a replay file
+	 */
+	class ReplayReader
+	{
+	public:
+		/**
+		 * @brief Open a replay file
+		 * @param path Replay file, memory-mapped for the reader's lifetime
+		 * @throws std::runtime_error if the file is not a valid replay
+		 */
+		explicit ReplayReader(const std::filesystem::path& path);
+
+		/**
+		 * @brief Get the first recorded turn
+		 * @return Turn of the first keyframe
+		 */
+		[[nodiscard]]
+		auto firstTurn() const noexcept -> TurnNumber
+		{
+			return _firstTurn;
+		}
+
+		/**
+		 * @brief Get the last recorded turn
+		 * @return Turn of the last frame
+		 */
+		[[nodiscard]]
+		auto lastTurn() const noexcept -> TurnNumber
+		{
+			return _lastTurn;
+		}
+
+		/**
+		 * @brief Rebuild the battlefield at the end of a turn
+		 *
+		 * Turns after the last frame return the final state.
+		 *
+		 * @param turn Turn to rebuild
+		 * @return Units in turn order
+		 * @throws std::out_of_range if the turn precedes the first frame
+		 * @throws std::runtime_error if the file is corrupt
+		 */
+		[[nodiscard]]
+		auto stateAt(TurnNumber turn) const -> std::vector<ReplayUnit>;
+
+	private:
+		io::MappedFile _file;			   ///< Mapped replay file
+		uint32_t _interval{1};			   ///< Turns per keyframe window
+		TurnNumber _firstTurn{0};		   ///< Turn of the first keyframe
+		TurnNumber _lastTurn{0};		   ///< Turn of the last frame
+		size_t _framesEnd{0};			   ///< Offset where the footer starts
+		std::vector<uint64_t> _keyframes;  ///< Keyframe offset of each window since the first
+	};
+
+}
@@ -1,35 +1,78 @@
 #include "Simulation.hpp"
 
 #include "AI.hpp"
+#include "Checkpoint.hpp"
 #include "Core/Types.hpp"
 #include "IO/Events/MarchEnded.hpp"
 #include "IO/Events/MarchStarted.hpp"
 #include "IO/Events/SimulationEnded.hpp"
 #include "IO/Events/SimulationStarted.hpp"
+#include "IO/Events/UnitMoved.hpp"
 #include "IO/System/EventLog.hpp"
 #include "Prefabs.hpp"
 
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace sw::core
 {
 
+	auto toString(const EndReason reason) -> const char*
+	{
+		switch (reason)
+		{
+			case EndReason::Stopped:
+				return "STOPPED";
+			case EndReason::TurnLimit:
+				return "TURN_LIMIT";
+			case EndReason::LastUnit:
+				return "LAST_UNIT";
+			case EndReason::NoAction:
+				return "NO_ACTION";
+			case EndReason::RepeatedState:
+				return "REPEATED_STATE";
+			case EndReason::NoDamage:
+				return "NO_DAMAGE";
+		}
+		return "UNKNOWN";
+	}
+
 	Simulation::Simulation() = default;
 
 	auto Simulation::createMap(const uint32_t width, const uint32_t height) -> bool
 	{
-		_world.reset(width, height, std::make_unique<sw::EventLog>());
+		_world.reset(width, height);
 		_marchTargets.clear();
 		_currentTurn = 1;
+		_phase = Phase::Setup;
+		_resumed = false;
+		_scheduled.clear();
+		if (_seed)
+		{
+			_world.randomEngine().seed(*_seed);
+		}
 		return true;
 	}
 
 	auto Simulation::spawnSwordsman(
-		const UnitId unitId, const uint32_t x, const uint32_t y, const HealthPoints hp, const StrengthValue strength)
-		-> bool
+		const UnitId unitId,
+		const uint32_t x,
+		const uint32_t y,
+		const HealthPoints hp,
+		const StrengthValue strength,
+		const FactionId faction) -> bool
 	{
 		if (_world.getEntity(unitId) != nullptr)
 		{
@@ -37,7 +80,8 @@ namespace sw::core
 		}
 
 		auto entity = makeSwordsman(unitId, Position{.x = x, .y = y}, SwordsmanConfig{.hp = hp, .strength = strength});
-		_world.addEntity(std::move(entity));
+		entity->setFaction(faction);
+		scheduleSpawnedUnit(_world.addEntity(std::move(entity), _currentTurn));
 		return true;
 	}
 
@@ -48,7 +92,8 @@ namespace sw::core
 		const HealthPoints hp,
 		const AgilityValue agility,
 		const StrengthValue strength,
-		const RangeValue range) -> bool
+		const RangeValue range,
+		const FactionId faction) -> bool
 	{
 		if (_world.getEntity(unitId) != nullptr)
 		{
@@ -59,37 +104,121 @@ namespace sw::core
 			unitId,
 			Position{.x = x, .y = y},
 			HunterConfig{.hp = hp, .agility = agility, .strength = strength, .range = range});
-		_world.addEntity(std::move(entity));
+		entity->setFaction(faction);
+		scheduleSpawnedUnit(_world.addEntity(std::move(entity), _currentTurn));
 		return true;
 	}
 
-	auto Simulation::executeMarch(const MarchCommand& command) -> bool
+	auto Simulation::spawnGrenadier(
+		const UnitId unitId,
+		const uint32_t x,
+		const uint32_t y,
+		const HealthPoints hp,
+		const StrengthValue strength,
+		const PowerValue power,
+		const RangeValue range,
+		const RangeValue radius,
+		const FactionId faction) -> bool
 	{
-		auto* entity = _world.getEntity(command.unitId);
-		if (entity == nullptr)
+		if (_world.getEntity(unitId) != nullptr)
 		{
 			return false;
 		}
 
-		const Position target{.x = command.x, .y = command.y};
-		if (!_world.map().isValidPosition(target))
+		auto entity = makeGrenadier(
+			unitId,
+			Position{.x = x, .y = y},
+			GrenadierConfig{.hp = hp, .strength = strength, .power = power, .range = range, .radius = radius});
+		entity->setFaction(faction);
+		scheduleSpawnedUnit(_world.addEntity(std::move(entity), _currentTurn));
+		return true;
+	}
+
+	auto Simulation::spawnUnit(
+		const UnitTemplate& unitTemplate,
+		const UnitId unitId,
+		const uint32_t x,
+		const uint32_t y,
+		const std::span<const uint32_t> stats,
+		const FactionId faction) -> bool
+	{
+		if (stats.size() != unitTemplate.stats.size())
+		{
+			throw std::invalid_argument(
+				unitTemplate.typeName + " takes " + std::to_string(unitTemplate.stats.size()) + " stats, got "
+				+ std::to_string(stats.size()));
+		}
+		if (_world.getEntity(unitId) != nullptr)
 		{
 			return false;
 		}
 
-		_marchTargets[command.unitId] = target;
+		auto entity = unitTemplate.instantiate(unitId, Position{.x = x, .y = y}, stats);
+		entity->setFaction(faction);
+		scheduleSpawnedUnit(_world.addEntity(std::move(entity), _currentTurn));
+		return true;
+	}
 
-		sw::io::MarchStarted event;
-		event.unitId = command.unitId;
-		event.x = entity->position().x;
-		event.y = entity->position().y;
-		event.targetX = target.x;
-		event.targetY = target.y;
-		_world.eventLog().log(_currentTurn, event);
+	auto Simulation::makePrototype(const std::string& typeName, const std::span<const uint32_t> values) const
+		-> std::unique_ptr<Entity>
+	{
+		const auto* prefab = findPrefabType(typeName);
+		const auto* unitTemplate = prefab == nullptr ? _catalog.find(typeName) : nullptr;
+		if (prefab == nullptr && unitTemplate == nullptr)
+		{
+			throw std::invalid_argument("Unknown unit type: " + typeName);
+		}
+
+		// One value past the type's stats is the faction
+		const size_t statCount = prefab != nullptr ? prefab->statCount : unitTemplate->stats.size();
+		if (values.size() != statCount && values.size() != statCount + 1)
+		{
+			throw std::invalid_argument(
+				typeName + " takes " + std::to_string(statCount) + " stats, got " + std::to_string(values.size()));
+		}
+
+		const auto stats = values.first(statCount);
+		auto prototype = prefab != nullptr ? prefab->make(0, Position{}, stats)
+										   : unitTemplate->instantiate(0, Position{}, stats);
+		prototype->setFaction(values.size() > statCount ? values.back() : NoFaction);
+		return prototype;
+	}
+
+	auto Simulation::spawnBlock(
+		const Entity& prototype, const UnitId firstId, const std::span<const Position> positions) -> bool
+	{
+		if (positions.empty())
+		{
+			return true;
+		}
+		if (positions.size() - 1 > std::numeric_limits<UnitId>::max() - firstId)
+		{
+			return false;
+		}
 
+		std::vector<std::unique_ptr<Entity>> copies;
+		copies.reserve(positions.size());
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			copies.push_back(prototype.clone(firstId + static_cast<UnitId>(i), positions[i]));
+		}
+		// The world validates the whole block first, so a bad cell spawns nothing
+		if (!_world.addEntities(std::move(copies), _currentTurn))
+		{
+			return false;
+		}
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			scheduleSpawnedUnit(*_world.getEntity(firstId + static_cast<UnitId>(i)));
+		}
 		return true;
 	}
 
+	void Simulation::loadUnitCatalog(const std::filesystem::path& path)
+	{
+		_catalog.loadFile(path);
+	}
+
 	auto Simulation::setMarchTarget(const MarchCommand& command) -> bool
 	{
 		auto* entity = _world.getEntity(command.unitId);
@@ -105,6 +234,10 @@ namespace sw::core
 		}
 
 		_marchTargets[command.unitId] = target;
+		if (_rules.sleepIdleUnits)
+		{
+			_activity.wakeAround(_world, entity->position());
+		}
 
 		sw::io::MarchStarted event;
 		event.unitId = command.unitId;
@@ -112,63 +245,542 @@ namespace sw::core
 		event.y = entity->position().y;
 		event.targetX = target.x;
 		event.targetY = target.y;
-		_world.eventLog().log(1, event);  // Log at turn 1 during setup
+		_world.eventLog().log(_currentTurn, event);  // Turn 1 during setup, the AT turn when scheduled
 
 		return true;
 	}
 
 	void Simulation::runSimulation(TurnNumber maxTurns)
 	{
-		// Log simulation start
+		start();
+		while (_currentTurn <= maxTurns && advanceTurn(maxTurns - _currentTurn + 1) != 0)
+		{
+		}
+		if (_phase == Phase::Running)
+		{
+			_endReason = EndReason::TurnLimit;
+		}
+		finish();
+	}
+
+	void Simulation::start()
+	{
+		if (_phase != Phase::Setup)
+		{
+			return;
+		}
+
+		_phase = Phase::Running;
+		_endReason = EndReason::Stopped;
+		// A resumed run keeps counting towards the stalemate rules from where the checkpointed run was,
+		// and keeps its sleepers asleep when the checkpointed run scheduled idle units too
+		const bool resumed = std::exchange(_resumed, false);
+		if (!resumed)
+		{
+			_startTurn = _currentTurn;
+			_recentHashes.clear();
+		}
+		resizeStateHashWindow(_rules.repeatedStateWindow);
+		if (_rules.sleepIdleUnits && (!resumed || _activity.wakeRadius() == 0))
+		{
+			_activity.assign(_world.entityOrder());
+			_activity.setWakeRadius(wakeRadiusForUnits());
+		}
+
 		sw::io::SimulationStarted startEvent;
 		startEvent.unitCount = getActiveUnitCount();
 		startEvent.turn = _currentTurn;
 		_world.eventLog().log(_currentTurn, startEvent);
+	}
 
-		TurnNumber startTurn = _currentTurn;
+	auto Simulation::step(const TurnNumber turns) -> TurnNumber
+	{
+		start();
 
-		for (; _currentTurn <= maxTurns; ++_currentTurn)
+		TurnNumber completed = 0;
+		while (completed < turns)
 		{
-			if (shouldEndSimulation())
+			const TurnNumber advanced = advanceTurn(turns - completed);
+			if (advanced == 0)
 			{
 				break;
 			}
+			completed += advanced;
+		}
+		return completed;
+	}
 
-			bool actionPerformed = processTurn();
-			cleanupMarchTargets();
-			_world.flushPendingRemovals();
-
-			if (!actionPerformed)
-			{
-				break;
-			}
+	void Simulation::finish()
+	{
+		if (_phase == Phase::Finished)
+		{
+			return;
 		}
+		start();
+		_phase = Phase::Finished;
 
-		// Log simulation end
 		sw::io::SimulationEnded endEvent;
 		endEvent.finalTurn = _currentTurn;
 		endEvent.survivors = getActiveUnitCount();
-		endEvent.totalTurns = _currentTurn - startTurn;
+		endEvent.totalTurns = _currentTurn - _startTurn;
+		endEvent.reason = toString(_endReason);
 		_world.eventLog().log(_currentTurn, endEvent);
 	}
 
-	auto Simulation::getActiveUnitCount() const -> size_t
+	auto Simulation::advanceTurn(const TurnNumber budget) -> TurnNumber
+	{
+		if (_phase != Phase::Running)
+		{
+			return 0;
+		}
+
+		applyScheduledCommands();
+		while (shouldEndSimulation())
+		{
+			if (!skipToNextScheduledTurn())
+			{
+				end(EndReason::LastUnit);
+				return 0;
+			}
+		}
+
+		if (const TurnNumber skipped = fastForwardMarches(budget); skipped != 0)
+		{
+			return skipped;
+		}
+
+		bool actionPerformed = processTurn();
+		_world.resolveDamage(_currentTurn);
+		cleanupMarchTargets();
+		_world.flushPendingRemovals();
+
+		if (_turnHashListener)
+		{
+			_turnHashListener(_currentTurn, _world.stateHash());
+		}
+
+		if (!actionPerformed)
+		{
+			if (skipToNextScheduledTurn())
+			{
+				return 1;
+			}
+			end(EndReason::NoAction);
+			return 0;
+		}
+
+		detectStalemate(_currentTurn);
+		if (_phase == Phase::Running && _checkpoints.interval != 0 && _currentTurn % _checkpoints.interval == 0)
+		{
+			writeCheckpoint(_checkpoints.path, captureCheckpoint(_currentTurn + 1));
+		}
+		++_currentTurn;
+		return 1;
+	}
+
+	void Simulation::end(const EndReason reason)
+	{
+		_phase = Phase::Ended;
+		_endReason = reason;
+	}
+
+	void Simulation::detectStalemate(const TurnNumber turn)
+	{
+		if (_rules.turnsWithoutDamage != 0)
+		{
+			const TurnNumber quietSince = std::max(_world.lastDamageTurn(), _startTurn - 1);
+			if (turn - quietSince >= _rules.turnsWithoutDamage)
+			{
+				end(EndReason::NoDamage);
+				return;
+			}
+		}
+
+		if (!_recentHashes.empty())
+		{
+			const uint64_t hash = _world.stateHash();
+			if (std::ranges::find(_recentHashes, hash) != _recentHashes.end())
+			{
+				end(EndReason::RepeatedState);
+				return;
+			}
+			recordStateHash(hash);
+		}
+	}
+
+	void Simulation::recordStateHash(const uint64_t hash)
+	{
+		_recentHashes[_recentHashCursor] = hash;
+		_recentHashCursor = (_recentHashCursor + 1) % _recentHashes.size();
+	}
+
+	void Simulation::resizeStateHashWindow(const size_t window)
+	{
+		std::vector<uint64_t> previous(window, 0);
+		previous.swap(_recentHashes);
+		const size_t cursor = std::exchange(_recentHashCursor, 0);
+		if (window == 0)
+		{
+			return;
+		}
+		// Oldest first, so a smaller window keeps the most recent hashes
+		for (size_t i = 0; i < previous.size(); ++i)
+		{
+			recordStateHash(previous[(cursor + i) % previous.size()]);
+		}
+	}
+
+	auto Simulation::fastForwardMarches(const TurnNumber budget) -> TurnNumber
+	{
+		if (!_rules.fastForwardMarches || budget < 2 || _commandSource)
+		{
+			return 0;
+		}
+
+		// Stop before the next scheduled command, at the next checkpoint turn and
+		// at the turn the no-damage rule would end the simulation
+		TurnNumber turns = budget;
+		if (_rules.turnsWithoutDamage != 0)
+		{
+			const TurnNumber quietSince = std::max(_world.lastDamageTurn(), _startTurn - 1);
+			turns = std::min(turns, quietSince + _rules.turnsWithoutDamage - _currentTurn + 1);
+		}
+		if (!_scheduled.empty())
+		{
+			turns = std::min(turns, _scheduled.front().turn - _currentTurn);
+		}
+		if (_checkpoints.interval != 0)
+		{
+			const TurnNumber untilCheckpoint = _checkpoints.interval - (_currentTurn % _checkpoints.interval);
+			turns = std::min(turns, (untilCheckpoint % _checkpoints.interval) + 1);
+		}
+
+		// Every unit must be marching, predictably, and must not arrive within the span
+		_marchers.clear();
+		for (const UnitId id : _world.entityOrder())
+		{
+			auto* entity = _world.getEntity(id);
+			const auto marchIt = _marchTargets.find(id);
+			const auto movement = entity->movement();
+			if (!_world.isAlive(*entity) || marchIt == _marchTargets.end() || !movement)
+			{
+				return 0;
+			}
+
+			turns = std::min(turns, (*movement)->predictableTurns(entity->position(), marchIt->second));
+			if (turns < 2)
+			{
+				return 0;
+			}
+			_marchers.emplace_back(entity, marchIt->second);
+		}
+
+		// Units close in by at most two cells per turn; any pair at distance d
+		// can safely make (d - 1) / 2 moves before one could block the other
+		for (const auto& [entity, target] : _marchers)
+		{
+			_world.map().forEachUnitInRange(
+				entity->position(),
+				2 * turns,
+				[&](const SpatialIndex::Entry& other)
+				{
+					if (other.id != entity->id())
+					{
+						turns = std::min(turns, (entity->position().distanceTo(other.position) - 1) / 2);
+					}
+				});
+			if (turns < 2)
+			{
+				return 0;
+			}
+		}
+
+		// Moved events nobody consumes are not worth replaying turn by turn
+		const bool reportMoves = _rules.reportSkippedMoves && _world.eventLog().wants<sw::io::UnitMoved>();
+		if (reportMoves || _turnHashListener)
+		{
+			for (TurnNumber i = 0; i < turns; ++i, ++_currentTurn)
+			{
+				for (auto& [entity, target] : _marchers)
+				{
+					const Position next = (*entity->movement())->predictPosition(entity->position(), target, 1);
+					_world.relocate(*entity, next);
+					if (reportMoves)
+					{
+						sw::io::UnitMoved event;
+						event.unitId = entity->id();
+						event.x = next.x;
+						event.y = next.y;
+						_world.eventLog().log(_currentTurn, event);
+					}
+				}
+
+				if (_turnHashListener)
+				{
+					_turnHashListener(_currentTurn, _world.stateHash());
+				}
+			}
+		}
+		else
+		{
+			for (auto& [entity, target] : _marchers)
+			{
+				_world.relocate(*entity, (*entity->movement())->predictPosition(entity->position(), target, turns));
+			}
+			_currentTurn += turns;
+		}
+
+		detectStalemate(_currentTurn - 1);
+		if (const TurnNumber lastTurn = _currentTurn - 1;
+			_phase == Phase::Running && _checkpoints.interval != 0 && lastTurn % _checkpoints.interval == 0)
+		{
+			writeCheckpoint(_checkpoints.path, captureCheckpoint(_currentTurn));
+		}
+		return turns;
+	}
+
+	void Simulation::schedule(const TurnNumber turn, ScheduledAction action)
+	{
+		_scheduled.push_back({.turn = turn, .sequence = _scheduleSequence++, .action = std::move(action)});
+		std::ranges::push_heap(_scheduled, std::greater<>{});
+	}
+
+	void Simulation::setCommandInterpreter(CommandInterpreter interpreter)
+	{
+		_commandInterpreter = std::move(interpreter);
+	}
+
+	void Simulation::scheduleCommand(const TurnNumber turn, std::string commandLine)
+	{
+		_scheduled.push_back({.turn = turn, .sequence = _scheduleSequence++, .commandLine = std::move(commandLine)});
+		std::ranges::push_heap(_scheduled, std::greater<>{});
+	}
+
+	void Simulation::setCommandSource(CommandSource source)
+	{
+		_commandSource = std::move(source);
+	}
+
+	void Simulation::applyScheduledCommands()
+	{
+		if (_commandSource && !_commandSource(_currentTurn))
+		{
+			_commandSource = nullptr;
+		}
+
+		while (!_scheduled.empty() && _scheduled.front().turn <= _currentTurn)
+		{
+			std::ranges::pop_heap(_scheduled, std::greater<>{});
+			ScheduledCommand command = std::move(_scheduled.back());
+			_scheduled.pop_back();
+			if (command.action)
+			{
+				command.action();
+			}
+			else
+			{
+				_commandInterpreter(command.commandLine);
+			}
+		}
+	}
+
+	auto Simulation::skipToNextScheduledTurn() -> bool
+	{
+		if (_scheduled.empty())
+		{
+			return false;
+		}
+
+		_currentTurn = std::max(_currentTurn + 1, _scheduled.front().turn);
+		applyScheduledCommands();
+		return true;
+	}
+
+	void Simulation::setRules(const SimulationRules& rules)
+	{
+		_rules = rules;
+		_world.setAIOptions({.incremental = rules.incrementalAI, .stickyTargets = rules.stickyTargets});
+		_world.setDamageResolution(
+			rules.simultaneousDamage ? World::DamageResolution::Simultaneous : World::DamageResolution::Sequential);
+	}
+
+	auto Simulation::wakeRadiusForUnits() const -> RangeValue
 	{
-		size_t count = 0;
+		if (_rules.wakeRadius != 0)
+		{
+			return _rules.wakeRadius;
+		}
+
+		RangeValue radius = 1;
 		for (const auto& entity : _world.entities() | std::views::values)
 		{
-			if (entity && entity->isAlive())
+			for (const auto& attack : entity->attacks())
+			{
+				radius = std::max(radius, attack->reach());
+			}
+		}
+		return radius;
+	}
+
+	void Simulation::scheduleSpawnedUnit(const Entity& entity)
+	{
+		if (!_rules.sleepIdleUnits || _phase == Phase::Setup)
+		{
+			return;
+		}
+
+		if (_rules.wakeRadius == 0)
+		{
+			for (const auto& attack : entity.attacks())
+			{
+				_activity.setWakeRadius(std::max(_activity.wakeRadius(), attack->reach()));
+			}
+		}
+		_activity.addUnit(entity.id());
+		_activity.wakeAround(_world, entity.position());
+	}
+
+	void Simulation::seedRandom(const uint32_t seed)
+	{
+		_seed = seed;
+		_world.randomEngine().seed(seed);
+	}
+
+	void Simulation::setTurnHashListener(TurnHashListener listener)
+	{
+		_turnHashListener = std::move(listener);
+	}
+
+	void Simulation::enableCheckpoints(CheckpointConfig config)
+	{
+		_checkpoints = std::move(config);
+	}
+
+	void Simulation::saveCheckpoint(const std::filesystem::path& path) const
+	{
+		writeCheckpoint(path, captureCheckpoint(_currentTurn));
+	}
+
+	void Simulation::loadCheckpoint(const std::filesystem::path& path)
+	{
+		const CheckpointData data = readCheckpoint(path);
+
+		std::vector<std::unique_ptr<Entity>> entities;
+		std::vector<UnitId> sleeping;
+		entities.reserve(data.units.size());
+		for (const auto& unit : data.units)
+		{
+			entities.push_back(restoreUnit(unit, _catalog));
+			if (unit.asleep)
+			{
+				sleeping.push_back(unit.id);
+			}
+		}
+		_world.restore(data.dimensions, std::move(entities));
+		_world.restoreLastDamageTurn(data.lastDamageTurn);
+		// Cached pursuit steps watch for map changes made after the restored units were placed
+		for (const auto& unit : data.units)
+		{
+			if (const auto ai = _world.getEntity(unit.id)->ai())
+			{
+				(*ai)->restorePursuitTarget(unit.pursuitTarget, _world);
+			}
+		}
+
+		_marchTargets.clear();
+		for (const auto& [id, target] : data.marches)
+		{
+			_marchTargets[id] = target;
+		}
+		_currentTurn = data.nextTurn;
+		_phase = Phase::Setup;
+		_startTurn = data.startTurn;
+		_recentHashes = data.recentHashes;
+		_recentHashCursor = 0;
+		_activity.assign(_world.entityOrder(), sleeping);
+		_activity.setWakeRadius(data.wakeRadius);
+		_resumed = true;
+
+		if (!data.commands.empty() && !_commandInterpreter)
+		{
+			throw std::runtime_error("Checkpoint holds scheduled commands but no command interpreter is set");
+		}
+		_scheduled.clear();
+		_scheduleSequence = 0;
+		for (const auto& command : data.commands)
+		{
+			_scheduled.push_back(
+				{.turn = command.turn, .sequence = command.sequence, .commandLine = command.commandLine});
+			_scheduleSequence = std::max(_scheduleSequence, command.sequence + 1);
+		}
+		std::ranges::make_heap(_scheduled, std::greater<>{});
+
+		std::istringstream rngState(data.rngState);
+		rngState >> _world.randomEngine();
+	}
+
+	auto Simulation::captureCheckpoint(const TurnNumber nextTurn) const -> CheckpointData
+	{
+		CheckpointData data;
+		data.dimensions = _world.map().dimensions();
+		data.nextTurn = nextTurn;
+
+		std::ostringstream rngState;
+		rngState << _world.randomEngine();
+		data.rngState = rngState.str();
+
+		const bool scheduling = _rules.sleepIdleUnits && _phase != Phase::Setup;
+		data.wakeRadius = scheduling ? _activity.wakeRadius() : 0;
+		data.units.reserve(_world.entityOrder().size());
+		for (const UnitId id : _world.entityOrder())
+		{
+			if (const auto* entity = _world.getEntity(id); entity != nullptr && _world.isAlive(*entity))
+			{
+				data.units.push_back(captureUnit(*entity));
+				data.units.back().asleep = scheduling && _activity.isAsleep(id);
+				if (const auto ai = entity->ai())
+				{
+					data.units.back().pursuitTarget = (*ai)->pursuitTarget(*entity, _world);
+				}
+			}
+		}
+
+		data.marches.assign(_marchTargets.begin(), _marchTargets.end());
+
+		data.commands.reserve(_scheduled.size());
+		for (const auto& command : _scheduled)
+		{
+			if (command.action)
 			{
-				++count;
+				throw std::runtime_error("Cannot checkpoint a scheduled action that is not a command line");
 			}
+			data.commands.push_back(
+				{.turn = command.turn, .sequence = command.sequence, .commandLine = command.commandLine});
+		}
+		std::ranges::sort(
+			data.commands,
+			[](const CheckpointCommand& lhs, const CheckpointCommand& rhs)
+			{ return std::tie(lhs.turn, lhs.sequence) < std::tie(rhs.turn, rhs.sequence); });
+
+		data.startTurn = _startTurn;
+		data.lastDamageTurn = _world.lastDamageTurn();
+		data.recentHashes.reserve(_recentHashes.size());
+		for (size_t i = 0; i < _recentHashes.size(); ++i)
+		{
+			data.recentHashes.push_back(_recentHashes[(_recentHashCursor + i) % _recentHashes.size()]);
 		}
-		return count;
+		return data;
+	}
+
+	auto Simulation::getActiveUnitCount() const -> size_t
+	{
+		return _world.livingUnitCount();
 	}
 
 	auto Simulation::isUnitActive(UnitId unitId) const -> bool
 	{
 		const auto* entity = _world.getEntity(unitId);
-		return entity != nullptr && entity->isAlive();
+		return entity != nullptr && _world.isAlive(*entity);
 	}
 
 	auto Simulation::getUnitPosition(UnitId unitId) const -> std::optional<Position>
@@ -189,15 +801,24 @@ namespace sw::core
 	auto Simulation::processTurn() -> bool
 	{
 		bool anyAction = false;
-		auto order = _world.entityOrder();
-		for (UnitId id : order)
+		// Snapshot the order: units spawned or removed mid-turn must not disturb iteration
+		const auto& order = _rules.sleepIdleUnits ? _activity.activeUnits(_world) : _world.entityOrder();
+		_turnOrder.assign(order.begin(), order.end());
+		for (const UnitId id : _turnOrder)
 		{
 			auto* entity = _world.getEntity(id);
-			if (entity == nullptr || !entity->isAlive())
+			if (entity == nullptr || !_world.isAlive(*entity))
 			{
 				continue;
 			}
 
+			const Position before = entity->position();
+			if (_rules.sleepIdleUnits && !_marchTargets.contains(id) && _activity.isIdle(*entity, _world))
+			{
+				_activity.sleep(id);
+				continue;
+			}
+
 			bool marched = false;
 			auto marchIt = _marchTargets.find(id);
 			if (marchIt != _marchTargets.end())
@@ -221,7 +842,7 @@ namespace sw::core
 
 			if (!marched)
 			{
-				if (auto ai = entity->ai(); ai && entity->isAlive())
+				if (auto ai = entity->ai(); ai && _world.isAlive(*entity))
 				{
 					if ((*ai)->update(*entity, _world, _currentTurn))
 					{
@@ -229,6 +850,11 @@ namespace sw::core
 					}
 				}
 			}
+
+			if (_rules.sleepIdleUnits && entity->position() != before)
+			{
+				_activity.wakeAround(_world, entity->position());
+			}
 		}
 
 		return anyAction;
@@ -238,7 +864,7 @@ namespace sw::core
 	{
 		for (auto it = _marchTargets.begin(); it != _marchTargets.end();)
 		{
-			if (const auto* entity = _world.getEntity(it->first); entity == nullptr || !entity->isAlive())
+			if (const auto* entity = _world.getEntity(it->first); entity == nullptr || !_world.isAlive(*entity))
 			{
 				it = _marchTargets.erase(it);
 			}
@@ -18,16 +18,118 @@
 
 #pragma once
 
+#include "ActivityScheduler.hpp"
+#include "Checkpoint.hpp"
 #include "Core/Types.hpp"
+#include "UnitCatalog.hpp"
 #include "World.hpp"
 
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <span>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace sw::core
 {
 
+	/**
+	 * @brief Optional rule changes trading exact default behaviour for speed
+	 */
+	struct SimulationRules
+	{
+		/**
+		 * @brief Put units with nothing within their wake radius to sleep
+		 *
+		 * Sleeping units skip their AI until a unit moves or spawns within the
+		 * wake radius, so they no longer pursue distant enemies across the map.
+		 */
+		bool sleepIdleUnits = false;
+
+		/**
+		 * @brief Wake radius for sleeping units (0 derives it from the longest attack reach)
+		 */
+		RangeValue wakeRadius = 0;
+
+		/**
+		 * @brief Jump the clock over stretches where every unit is marching far from the others
+		 *
+		 * Positions are computed analytically from the movement strategy. Only
+		 * used by runSimulation() and step(), never by runUntil(), and not while
+		 * a command source is attached.
+		 */
+		bool fastForwardMarches = false;
+
+		/**
+		 * @brief Log UNIT_MOVED for every fast-forwarded turn (false reports only the outcome)
+		 */
+		bool reportSkippedMoves = true;
+
+		/**
+		 * @brief End the simulation when a world state repeats within this many turns (0 disables)
+		 *
+		 * States are compared by their state hash (unit ids, positions and HP),
+		 * so units shuffling back and forth are detected as a stalemate.
+		 */
+		TurnNumber repeatedStateWindow = 0;
+
+		/**
+		 * @brief End the simulation after this many consecutive turns without damage (0 disables)
+		 */
+		TurnNumber turnsWithoutDamage = 0;
+
+		/**
+		 * @brief Let AI strategies repeat their last pursuit step while nothing changes nearby
+		 *
+		 * See detail::PursuitCache for when a cached decision is reused.
+		 */
+		bool incrementalAI = false;
+
+		/**
+		 * @brief Let AI strategies keep attacking the same target while it stays valid
+		 *
+		 * A new target is picked at random among enemies within reach only when
+		 * the current one dies or can no longer be attacked.
+		 */
+		bool stickyTargets = false;
+
+		/**
+		 * @brief Resolve every hit of a turn together at the end of the turn
+		 *
+		 * Units hit during a turn keep acting until it ends, so two units can
+		 * kill each other. Intended for statistics runs; see
+		 * World::resolveDamage() for the event order.
+		 */
+		bool simultaneousDamage = false;
+	};
+
+	/**
+	 * @brief Why a simulation run ended, reported in SIMULATION_ENDED
+	 */
+	enum class EndReason : std::uint8_t
+	{
+		Stopped,		///< finish() called while the simulation could still advance
+		TurnLimit,		///< runSimulation() reached its maximum turn
+		LastUnit,		///< At most one unit is left alive
+		NoAction,		///< A turn passed without any unit acting
+		RepeatedState,	///< A world state recurred within the configured window
+		NoDamage		///< No damage was dealt for the configured number of turns
+	};
+
+	/**
+	 * @brief Get the name of an end reason as reported in events
+	 * @param reason End reason
+	 * @return Upper-case reason name
+	 */
+	[[nodiscard]]
+	auto toString(EndReason reason) -> const char*;
+
 	/**
 	 * @brief Main simulation engine orchestrating the battle simulation lifecycle
 	 *
@@ -58,6 +160,10 @@ namespace sw::core
 
 		/**
 		 * @brief Create the simulation map
+		 *
+		 * Reseeds the AI random engine with the seed given to seedRandom(), if any,
+		 * so every scenario run on a reused simulation starts from the same stream.
+		 *
 		 * @param width Map width in grid units
 		 * @param height Map height in grid units
 		 * @return true if map creation was successful
@@ -71,9 +177,16 @@ namespace sw::core
 		 * @param y Initial y coordinate
 		 * @param hp Health points
 		 * @param strength Strength attribute for melee combat
+		 * @param faction Faction the unit fights for (NoFaction fights everyone)
 		 * @return true if spawning was successful
 		 */
-		auto spawnSwordsman(UnitId unitId, uint32_t x, uint32_t y, HealthPoints hp, StrengthValue strength) -> bool;
+		auto spawnSwordsman(
+			UnitId unitId,
+			uint32_t x,
+			uint32_t y,
+			HealthPoints hp,
+			StrengthValue strength,
+			FactionId faction = NoFaction) -> bool;
 
 		/**
 		 * @brief Spawn a hunter unit
@@ -84,6 +197,7 @@ namespace sw::core
 		 * @param agility Agility attribute for ranged combat
 		 * @param strength Strength attribute for melee combat
 		 * @param range Attack range for ranged weapons
+		 * @param faction Faction the unit fights for (NoFaction fights everyone)
 		 * @return true if spawning was successful
 		 */
 		auto spawnHunter(
@@ -93,27 +207,110 @@ namespace sw::core
 			HealthPoints hp,
 			AgilityValue agility,
 			StrengthValue strength,
-			RangeValue range) -> bool;
+			RangeValue range,
+			FactionId faction = NoFaction) -> bool;
 
 		/**
-		 * @brief Execute a march command (immediate execution)
-		 * @param unitId Unit to march
-		 * @param x Target x coordinate
-		 * @param y Target y coordinate
-		 * @return true if march command was successful
+		 * @brief Spawn a grenadier unit
+		 * @param unitId Unique identifier for the unit
+		 * @param x Initial x coordinate
+		 * @param y Initial y coordinate
+		 * @param hp Health points
+		 * @param strength Strength attribute for melee combat
+		 * @param power Damage dealt to each unit caught in a blast
+		 * @param range Maximum distance a bomb can be thrown
+		 * @param radius Blast radius around the cell a bomb lands on
+		 * @param faction Faction the unit fights for (NoFaction fights everyone)
+		 * @return true if spawning was successful
+		 */
+		auto spawnGrenadier(
+			UnitId unitId,
+			uint32_t x,
+			uint32_t y,
+			HealthPoints hp,
+			StrengthValue strength,
+			PowerValue power,
+			RangeValue range,
+			RangeValue radius,
+			FactionId faction = NoFaction) -> bool;
+
+		/**
+		 * @brief Spawn a unit of a catalog type
+		 * @param unitTemplate Type from unitCatalog()
+		 * @param unitId Unique identifier for the unit
+		 * @param x Initial x coordinate
+		 * @param y Initial y coordinate
+		 * @param stats Stat values in the order the type declares them
+		 * @param faction Faction the unit fights for (NoFaction fights everyone)
+		 * @return true if spawning was successful
+		 * @throws std::invalid_argument if the number of stats does not match the type
+		 */
+		auto spawnUnit(
+			const UnitTemplate& unitTemplate,
+			UnitId unitId,
+			uint32_t x,
+			uint32_t y,
+			std::span<const uint32_t> stats,
+			FactionId faction = NoFaction) -> bool;
+
+		/**
+		 * @brief Build an unplaced unit to copy with spawnBlock()
+		 * @param typeName Built-in prefab or catalog type
+		 * @param values Stats in the order the type takes them, optionally followed by a faction
+		 * @return Prototype entity (its id and position are placeholders)
+		 * @throws std::invalid_argument for unknown types or a wrong number of values
+		 */
+		[[nodiscard]]
+		auto makePrototype(const std::string& typeName, std::span<const uint32_t> values) const
+			-> std::unique_ptr<Entity>;
+
+		/**
+		 * @brief Spawn copies of a prototype with consecutive ids, one per position
+		 *
+		 * Storage for the whole block is reserved up front and every copy is
+		 * cloned from the prototype's components. UNIT_SPAWNED is logged for
+		 * each unit in position order, exactly as separate spawns would.
+		 *
+		 * @param prototype Unit to copy, e.g. from makePrototype()
+		 * @param firstId Identifier of the first copy; the others follow consecutively
+		 * @param positions Cells to fill, in spawn order
+		 * @return false (and nothing spawned) if an id is taken or a cell is outside the map or occupied
+		 */
+		auto spawnBlock(const Entity& prototype, UnitId firstId, std::span<const Position> positions) -> bool;
+
+		/**
+		 * @brief Add the unit types of a catalog file to unitCatalog()
+		 *
+		 * Load catalogs before resuming a checkpoint that contains their types.
+		 *
+		 * @param path Catalog file
+		 * @throws std::runtime_error if the file cannot be read or is invalid
+		 */
+		void loadUnitCatalog(const std::filesystem::path& path);
+
+		/**
+		 * @brief Get the data-driven unit types available to spawnUnit()
+		 * @return Const reference to the unit catalog
+		 */
+		[[nodiscard]]
+		auto unitCatalog() const noexcept -> const UnitCatalog&
+		{
+			return _catalog;
+		}
+
+		/**
+		 * @brief Unit and destination of a march
 		 */
 		struct MarchCommand
 		{
-			UnitId unitId;
-			uint32_t x;
-			uint32_t y;
+			UnitId unitId;	///< Unit to march
+			uint32_t x;		///< Target x coordinate
+			uint32_t y;		///< Target y coordinate
 		};
 
-		auto executeMarch(const MarchCommand& command) -> bool;
-
 		/**
-		 * @brief Set a march target for a unit (deferred execution)
-		 * @param command
+		 * @brief Set a march target for a unit; it moves towards it on the following turns
+		 * @param command Unit and destination
 		 * @return true if march target was set successfully
 		 */
 		auto setMarchTarget(const MarchCommand& command) -> bool;
@@ -122,10 +319,265 @@ namespace sw::core
 
 		/**
 		 * @brief Run the battle simulation
+		 *
+		 * Equivalent to start(), stepping until the simulation ends or maxTurns is
+		 * reached, then finish().
+		 *
 		 * @param maxTurns Maximum number of turns to run (default: unlimited)
 		 */
 		void runSimulation(TurnNumber maxTurns = std::numeric_limits<TurnNumber>::max());
 
+		// === Stepping API ===
+
+		/**
+		 * @brief Begin the simulation, logging SIMULATION_STARTED
+		 *
+		 * Called implicitly by step() and runUntil(); does nothing once started.
+		 */
+		void start();
+
+		/**
+		 * @brief Advance the simulation by up to the given number of turns
+		 * @param turns Number of turns to run
+		 * @return Number of turns actually completed (fewer if the simulation ended)
+		 */
+		auto step(TurnNumber turns = 1) -> TurnNumber;
+
+		/**
+		 * @brief Advance turn by turn until the predicate holds or the simulation ends
+		 *
+		 * The predicate is checked before every turn with read-only access to the
+		 * simulation, so an embedding controller can stop on any observable condition.
+		 *
+		 * @param stop Callable taking `const Simulation&` and returning true to stop
+		 * @return true if stopped by the predicate, false if the simulation ended first
+		 */
+		template <class TPredicate>
+		auto runUntil(TPredicate&& stop) -> bool
+		{
+			start();
+			while (!stop(std::as_const(*this)))
+			{
+				if (advanceTurn() == 0)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief End the simulation, logging SIMULATION_ENDED
+		 *
+		 * Does nothing if already finished. Further step() calls have no effect.
+		 */
+		void finish();
+
+		/**
+		 * @brief Check whether the simulation can still advance
+		 * @return true until an end condition is met or finish() is called
+		 */
+		[[nodiscard]]
+		auto isRunning() const noexcept -> bool
+		{
+			return _phase == Phase::Setup || _phase == Phase::Running;
+		}
+
+		/**
+		 * @brief Get why the simulation stopped advancing
+		 * @return End reason (meaningful once isRunning() returns false)
+		 */
+		[[nodiscard]]
+		auto endReason() const noexcept -> EndReason
+		{
+			return _endReason;
+		}
+
+		/**
+		 * @brief Get the number of the next turn to be processed
+		 * @return Current turn number
+		 */
+		[[nodiscard]]
+		auto currentTurn() const noexcept -> TurnNumber
+		{
+			return _currentTurn;
+		}
+
+		/**
+		 * @brief Read-only access to the simulation world
+		 * @return Const reference to the world
+		 */
+		[[nodiscard]]
+		auto world() const noexcept -> const World&
+		{
+			return _world;
+		}
+
+		// === Event Callbacks ===
+
+		/**
+		 * @brief Get the event log for output configuration and subscriptions
+		 * @return Reference to the event log
+		 */
+		[[nodiscard]]
+		auto eventLog() const -> sw::EventLog&
+		{
+			return _world.eventLog();
+		}
+
+		/**
+		 * @brief Subscribe a typed callback to one event type
+		 *
+		 * The callable is referenced, not copied, and must outlive the simulation's
+		 * use of it. Dispatch is a direct call with no allocation.
+		 *
+		 * @tparam TEvent Event type from IO/Events
+		 * @param callback Callable taking `(uint32_t turn, const TEvent& event)`
+		 */
+		template <class TEvent, class TCallable>
+		void onEvent(TCallable& callback)
+		{
+			_world.eventLog().subscribe(sw::EventCallback<TEvent>(callback));
+		}
+
+		/**
+		 * @brief Change optional simulation rules
+		 *
+		 * Takes effect at the next start() (AI options immediately); set it before running.
+		 *
+		 * @param rules Rules to apply
+		 */
+		void setRules(const SimulationRules& rules);
+
+		/**
+		 * @brief Seed the world's AI random engine for reproducible runs
+		 *
+		 * The seed is kept and applied again by every createMap().
+		 *
+		 * @param seed Seed value
+		 */
+		void seedRandom(uint32_t seed);
+
+		// === Scheduled Commands ===
+
+		/**
+		 * @brief Action applied to the simulation at a turn boundary
+		 */
+		using ScheduledAction = std::function<void()>;
+
+		/**
+		 * @brief Pulls more commands from an external stream
+		 *
+		 * Called at each turn boundary with the turn about to run. It must schedule
+		 * every command due by that turn and may schedule later ones; it returns
+		 * false once the stream is exhausted.
+		 */
+		using CommandSource = std::function<bool(TurnNumber)>;
+
+		/**
+		 * @brief Queue an action to run at the start of a turn
+		 *
+		 * Actions due at the same turn run in the order they were scheduled. Actions
+		 * for turns that already passed run at the next turn boundary.
+		 *
+		 * @param turn Turn at whose boundary the action runs
+		 * @param action Action to run (typically a parsed command)
+		 */
+		void schedule(TurnNumber turn, ScheduledAction action);
+
+		/**
+		 * @brief Runs a command line, typically through the scenario command parser
+		 */
+		using CommandInterpreter = std::function<void(const std::string&)>;
+
+		/**
+		 * @brief Set the interpreter that runs commands queued with scheduleCommand()
+		 * @param interpreter Command interpreter, also used for commands restored from a checkpoint
+		 */
+		void setCommandInterpreter(CommandInterpreter interpreter);
+
+		/**
+		 * @brief Queue a command line to run through the command interpreter at the start of a turn
+		 *
+		 * Ordered together with schedule() actions. Unlike those actions, queued
+		 * command lines are saved in checkpoints and queued again on resume.
+		 *
+		 * @param turn Turn at whose boundary the command runs
+		 * @param commandLine Command text passed to the interpreter
+		 */
+		void scheduleCommand(TurnNumber turn, std::string commandLine);
+
+		/**
+		 * @brief Attach a stream of turn-stamped commands consumed while running
+		 * @param source Command source, pulled at every turn boundary
+		 */
+		void setCommandSource(CommandSource source);
+
+		/**
+		 * @brief Check whether scheduled or streamed commands are still pending
+		 *
+		 * While commands are pending the simulation does not end: idle stretches
+		 * are skipped up to the next scheduled turn instead.
+		 *
+		 * @return true if the queue is non-empty or a command source is attached
+		 */
+		[[nodiscard]]
+		auto hasPendingCommands() const noexcept -> bool
+		{
+			return !_scheduled.empty() || static_cast<bool>(_commandSource);
+		}
+
+		// === State Hashing ===
+
+		/**
+		 * @brief Callback receiving the world state hash at the end of every turn
+		 */
+		using TurnHashListener = std::function<void(TurnNumber, uint64_t)>;
+
+		/**
+		 * @brief Register a listener for per-turn state hashes
+		 * @param listener Callback invoked after each turn's removals are flushed (empty to disable)
+		 */
+		void setTurnHashListener(TurnHashListener listener);
+
+		/**
+		 * @brief Get the current world state hash
+		 * @return 64-bit fingerprint of all unit ids, positions and HP
+		 */
+		[[nodiscard]]
+		auto stateHash() const noexcept -> uint64_t
+		{
+			return _world.stateHash();
+		}
+
+		// === Checkpointing ===
+
+		/**
+		 * @brief Enable periodic checkpoints from runSimulation
+		 * @param config Destination file and interval in turns (interval 0 disables checkpointing)
+		 */
+		void enableCheckpoints(CheckpointConfig config);
+
+		/**
+		 * @brief Write a checkpoint of the current state
+		 * @param path Destination file, replaced atomically
+		 * @throws std::runtime_error on I/O failure, or if an action queued with schedule() is pending
+		 */
+		void saveCheckpoint(const std::filesystem::path& path) const;
+
+		/**
+		 * @brief Replace the current state with a checkpoint image
+		 *
+		 * The simulation continues from the stored turn when runSimulation is called;
+		 * scenario commands do not need to be replayed. Pending scheduled command
+		 * lines are queued again and run through the command interpreter.
+		 *
+		 * @param path Checkpoint file
+		 * @throws std::runtime_error if the checkpoint cannot be read or restored, or if it holds
+		 *         scheduled commands and no command interpreter is set
+		 */
+		void loadCheckpoint(const std::filesystem::path& path);
+
 		// === State Queries ===
 
 		/**
@@ -151,10 +603,72 @@ namespace sw::core
 		[[nodiscard]]
 		auto getUnitPosition(UnitId unitId) const -> std::optional<Position>;
 
+		/**
+		 * @brief Get a read-only view of every unit's state in turn order
+		 *
+		 * Prefer this over per-unit queries when reading the whole battlefield.
+		 * The span is invalidated by the next spawn or turn.
+		 *
+		 * @return Contiguous span of (id, x, y, hp, type) rows
+		 */
+		[[nodiscard]]
+		auto unitStates() const noexcept -> std::span<const UnitState>
+		{
+			return _world.unitStates();
+		}
+
 	private:
+		/**
+		 * @brief Queued action with the turn it is due at
+		 */
+		struct ScheduledCommand
+		{
+			TurnNumber turn;
+			uint64_t sequence;
+			ScheduledAction action;
+			std::string commandLine;  ///< Command run through the interpreter when there is no action
+
+			/**
+			 * @brief Heap ordering: earliest turn first, then scheduling order
+			 */
+			auto operator>(const ScheduledCommand& other) const noexcept -> bool
+			{
+				return turn != other.turn ? turn > other.turn : sequence > other.sequence;
+			}
+		};
+
+		/**
+		 * @brief Lifecycle phase of the simulation run
+		 */
+		enum class Phase : std::uint8_t
+		{
+			Setup,	  ///< Accepting commands, not yet started
+			Running,  ///< Started, turns can be advanced
+			Ended,	  ///< An end condition was met, SIMULATION_ENDED not yet logged
+			Finished  ///< SIMULATION_ENDED logged
+		};
+
 		World _world;										 ///< The simulation world containing all entities
 		TurnNumber _currentTurn{1};							 ///< Current turn number
+		TurnNumber _startTurn{1};							 ///< Turn at which start() was called
+		Phase _phase{Phase::Setup};							 ///< Lifecycle phase
+		bool _resumed{false};								 ///< Stalemate state came from a checkpoint
 		std::unordered_map<UnitId, Position> _marchTargets;	 ///< Active march targets for autonomous movement
+		CheckpointConfig _checkpoints;						 ///< Periodic checkpoint settings
+		TurnHashListener _turnHashListener;					 ///< Per-turn state hash consumer
+		std::vector<UnitId> _turnOrder;						 ///< Reused per-turn snapshot of the turn order
+		std::vector<ScheduledCommand> _scheduled;			 ///< Min-heap of turn-stamped commands
+		uint64_t _scheduleSequence{0};						 ///< Tie-breaker preserving scheduling order
+		CommandSource _commandSource;						 ///< Optional stream of further commands
+		CommandInterpreter _commandInterpreter;				 ///< Runs scheduled command lines
+		SimulationRules _rules;								 ///< Optional rule changes
+		ActivityScheduler _activity;						 ///< Awake units when idle units sleep
+		std::vector<std::pair<Entity*, Position>> _marchers;	 ///< Reused list of fast-forwarded units and targets
+		EndReason _endReason{EndReason::Stopped};			 ///< Why the simulation stopped advancing
+		std::vector<uint64_t> _recentHashes;				 ///< Ring buffer of recent end-of-turn state hashes
+		size_t _recentHashCursor{0};						 ///< Next slot to overwrite in _recentHashes
+		UnitCatalog _catalog;								 ///< Data-driven unit types
+		std::optional<uint32_t> _seed;						 ///< Seed reapplied to the random engine on createMap
 
 		/**
 		 * @brief Check if the simulation should end
@@ -163,16 +677,91 @@ namespace sw::core
 		[[nodiscard]]
 		auto shouldEndSimulation() const -> bool;
 
+		/**
+		 * @brief Run one full turn including cleanup, hashing and checkpointing
+		 *
+		 * With fast-forward enabled, several uncontested march turns may be
+		 * completed at once.
+		 *
+		 * @param budget Maximum number of turns to complete
+		 * @return Number of turns completed, or 0 if the simulation cannot continue
+		 */
+		auto advanceTurn(TurnNumber budget = 1) -> TurnNumber;
+
+		/**
+		 * @brief Stop advancing with the given reason
+		 * @param reason Reason reported when the simulation is finished
+		 */
+		void end(EndReason reason);
+
+		/**
+		 * @brief Apply the stalemate rules to the turn that just completed, ending the run if one triggers
+		 * @param turn Completed turn
+		 */
+		void detectStalemate(TurnNumber turn);
+
+		/**
+		 * @brief Complete several turns at once if every unit is on an uncontested march
+		 * @param budget Maximum number of turns to complete
+		 * @return Number of turns completed (0 if fast-forwarding is not possible)
+		 */
+		auto fastForwardMarches(TurnNumber budget) -> TurnNumber;
+
+		/**
+		 * @brief Pull streamed commands and run every scheduled command due by the current turn
+		 */
+		void applyScheduledCommands();
+
+		/**
+		 * @brief Jump the clock to the next scheduled command, if any
+		 * @return true if a command is pending and the clock was advanced to it
+		 */
+		auto skipToNextScheduledTurn() -> bool;
+
 		/**
 		 * @brief Process one turn of the simulation
 		 * @return true if any actions were performed during the turn
 		 */
 		auto processTurn() -> bool;
 
+		/**
+		 * @brief Compute the wake radius covering every unit's attack reach
+		 * @return Configured wake radius, or the longest reach of any living unit
+		 */
+		[[nodiscard]]
+		auto wakeRadiusForUnits() const -> RangeValue;
+
+		/**
+		 * @brief Let the activity scheduler know about a unit spawned while running
+		 * @param entity Newly added entity
+		 */
+		void scheduleSpawnedUnit(const Entity& entity);
+
 		/**
 		 * @brief Clean up march targets for inactive units
 		 */
 		void cleanupMarchTargets();
+
+		/**
+		 * @brief Push an end-of-turn state hash into the repeated-state window
+		 * @param hash State hash of the finished turn
+		 */
+		void recordStateHash(uint64_t hash);
+
+		/**
+		 * @brief Resize the repeated-state window, keeping the most recent hashes
+		 * @param window New number of remembered hashes (0 disables the rule)
+		 */
+		void resizeStateHashWindow(size_t window);
+
+		/**
+		 * @brief Capture the current state into a checkpoint image
+		 * @param nextTurn Turn the restored simulation should run next
+		 * @return Checkpoint image
+		 * @throws std::runtime_error if an action queued with schedule() is pending
+		 */
+		[[nodiscard]]
+		auto captureCheckpoint(TurnNumber nextTurn) const -> CheckpointData;
 	};
 
 }
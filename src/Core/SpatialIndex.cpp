@@ -0,0 +1,219 @@
+#include "SpatialIndex.hpp"
+
+#include "Core/Types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sw::core
+{
+	namespace
+	{
+		constexpr uint32_t MinBucketSize = 8;
+		constexpr uint64_t MaxBucketCount = uint64_t{1} << 20U;
+		constexpr uint32_t RegionSpan = 16;	 // Buckets along each side of a change-stamp region
+
+		constexpr auto bucketsAlong(uint32_t extent, uint32_t bucketSize) -> uint64_t
+		{
+			return (uint64_t{extent} + bucketSize - 1) / bucketSize;
+		}
+	}
+
+	void SpatialIndex::reset(const uint32_t width, const uint32_t height)
+	{
+		_width = width;
+		_height = height;
+
+		_bucketSize = MinBucketSize;
+		while (bucketsAlong(width, _bucketSize) * bucketsAlong(height, _bucketSize) > MaxBucketCount)
+		{
+			_bucketSize *= 2;
+		}
+		_bucketsX = static_cast<uint32_t>(bucketsAlong(width, _bucketSize));
+
+		const auto bucketCount = static_cast<size_t>(_bucketsX * bucketsAlong(height, _bucketSize));
+		for (auto& bucket : _buckets)
+		{
+			bucket.clear();
+		}
+		_buckets.resize(bucketCount);
+		_stamps.assign(bucketCount, 0);
+
+		const auto bucketsY = static_cast<uint32_t>(bucketsAlong(height, _bucketSize));
+		_regionsX = (_bucketsX + RegionSpan - 1) / RegionSpan;
+		_regionStamps.assign(static_cast<size_t>(_regionsX) * ((bucketsY + RegionSpan - 1) / RegionSpan), 0);
+		_blocksX = (_bucketsX + BlockSpan - 1) / BlockSpan;
+		_blockCounts.assign(static_cast<size_t>(_blocksX) * ((bucketsY + BlockSpan - 1) / BlockSpan), 0);
+	}
+
+	void SpatialIndex::insert(const UnitId id, const Position position)
+	{
+		touchBucket(position).push_back({.id = id, .position = position});
+		++_blockCounts[blockIndex(position)];
+	}
+
+	void SpatialIndex::insertBatch(const std::span<const Entry> entries)
+	{
+		if (entries.empty())
+		{
+			return;
+		}
+
+		const uint64_t stamp = ++_clock;
+		for (const Entry& entry : entries)
+		{
+			const size_t index = bucketIndex(entry.position);
+			const uint32_t bx = entry.position.x / _bucketSize;
+			const uint32_t by = entry.position.y / _bucketSize;
+			_buckets[index].push_back(entry);
+			_stamps[index] = stamp;
+			_regionStamps[(static_cast<size_t>(by / RegionSpan) * _regionsX) + (bx / RegionSpan)] = stamp;
+			++_blockCounts[blockIndex(entry.position)];
+		}
+	}
+
+	void SpatialIndex::remove(const UnitId id, const Position position)
+	{
+		auto& bucket = touchBucket(position);
+		const auto it = std::ranges::find(bucket, id, &Entry::id);
+		if (it != bucket.end())
+		{
+			*it = bucket.back();
+			bucket.pop_back();
+			--_blockCounts[blockIndex(position)];
+		}
+	}
+
+	void SpatialIndex::removeBatch(const std::span<const Entry> entries)
+	{
+		if (entries.empty())
+		{
+			return;
+		}
+
+		const uint64_t stamp = ++_clock;
+		for (const Entry& entry : entries)
+		{
+			const size_t index = bucketIndex(entry.position);
+			const uint32_t bx = entry.position.x / _bucketSize;
+			const uint32_t by = entry.position.y / _bucketSize;
+			auto& bucket = _buckets[index];
+			_stamps[index] = stamp;
+			_regionStamps[(static_cast<size_t>(by / RegionSpan) * _regionsX) + (bx / RegionSpan)] = stamp;
+			const auto it = std::ranges::find(bucket, entry.id, &Entry::id);
+			if (it != bucket.end())
+			{
+				*it = bucket.back();
+				bucket.pop_back();
+				--_blockCounts[blockIndex(entry.position)];
+			}
+		}
+	}
+
+	void SpatialIndex::move(const UnitId id, const Position from, const Position to)
+	{
+		auto& source = touchBucket(from);
+		auto& destination = touchBucket(to);
+		const auto it = std::ranges::find(source, id, &Entry::id);
+		if (&source == &destination)
+		{
+			if (it != source.end())
+			{
+				it->position = to;
+			}
+			return;
+		}
+
+		if (it != source.end())
+		{
+			*it = source.back();
+			source.pop_back();
+			--_blockCounts[blockIndex(from)];
+		}
+		destination.push_back({.id = id, .position = to});
+		++_blockCounts[blockIndex(to)];
+	}
+
+	auto SpatialIndex::unitAt(const Position position) const -> std::optional<UnitId>
+	{
+		if (!position.isWithin(_width, _height))
+		{
+			return std::nullopt;
+		}
+
+		for (const Entry& entry : _buckets[bucketIndex(position)])
+		{
+			if (entry.position == position)
+			{
+				return entry.id;
+			}
+		}
+		return std::nullopt;
+	}
+
+	auto SpatialIndex::changedSince(const Position center, const uint32_t radius, const uint64_t stamp) const -> bool
+	{
+		if (_clock == stamp || _buckets.empty())
+		{
+			return _clock != stamp;
+		}
+
+		const uint32_t minX = center.x > radius ? center.x - radius : 0U;
+		const uint32_t minY = center.y > radius ? center.y - radius : 0U;
+		const auto maxX = static_cast<uint32_t>(std::min<uint64_t>(_width - 1, uint64_t{center.x} + radius));
+		const auto maxY = static_cast<uint32_t>(std::min<uint64_t>(_height - 1, uint64_t{center.y} + radius));
+		const uint32_t firstBx = minX / _bucketSize;
+		const uint32_t lastBx = maxX / _bucketSize;
+		const uint32_t firstBy = minY / _bucketSize;
+		const uint32_t lastBy = maxY / _bucketSize;
+
+		for (uint32_t ry = firstBy / RegionSpan; ry <= lastBy / RegionSpan; ++ry)
+		{
+			for (uint32_t rx = firstBx / RegionSpan; rx <= lastBx / RegionSpan; ++rx)
+			{
+				if (_regionStamps[(static_cast<size_t>(ry) * _regionsX) + rx] <= stamp)
+				{
+					continue;
+				}
+
+				// Region changed: look at the buckets it shares with the query
+				const uint32_t fromBy = std::max(firstBy, ry * RegionSpan);
+				const uint32_t toBy = std::min(lastBy, (ry * RegionSpan) + RegionSpan - 1);
+				const uint32_t fromBx = std::max(firstBx, rx * RegionSpan);
+				const uint32_t toBx = std::min(lastBx, (rx * RegionSpan) + RegionSpan - 1);
+				for (uint32_t by = fromBy; by <= toBy; ++by)
+				{
+					for (uint32_t bx = fromBx; bx <= toBx; ++bx)
+					{
+						if (_stamps[(static_cast<size_t>(by) * _bucketsX) + bx] > stamp)
+						{
+							return true;
+						}
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	auto SpatialIndex::blockIndex(const Position position) const noexcept -> size_t
+	{
+		const uint32_t bx = position.x / _bucketSize;
+		const uint32_t by = position.y / _bucketSize;
+		return (static_cast<size_t>(by / BlockSpan) * _blocksX) + (bx / BlockSpan);
+	}
+
+	auto SpatialIndex::touchBucket(const Position position) -> std::vector<Entry>&
+	{
+		const size_t index = bucketIndex(position);
+		_stamps[index] = ++_clock;
+		const uint32_t bx = position.x / _bucketSize;
+		const uint32_t by = position.y / _bucketSize;
+		_regionStamps[(static_cast<size_t>(by / RegionSpan) * _regionsX) + (bx / RegionSpan)] = _clock;
+		return _buckets[index];
+	}
+
+}
@@ -0,0 +1,313 @@
+/**
+ * @file SpatialIndex.hpp
+ * @brief Uniform bucket grid for fast neighbourhood queries on the map.
+ *
+ * The index partitions the map into square buckets and stores each unit in the
+ * bucket covering its cell. Range queries only touch the buckets overlapping
+ * the query square, so their cost depends on local density rather than on the
+ * total number of units.
+ *
+ * Each bucket also carries a change stamp, bumped whenever a unit enters or
+ * leaves it, so callers can cheaply ask whether anything changed near a cell
+ * since they last looked. Square regions of buckets carry a stamp too, so
+ * large unchanged areas are skipped without visiting their buckets.
+ *
+ * Key responsibilities:
+ * - Unit insertion and removal (singly or in bulk) and relocation between buckets
+ * - Chebyshev-radius range queries
+ * - Nearest-unit search that skips empty regions
+ * - Point lookup of the unit occupying a cell
+ * - Dirty-region tracking through per-bucket change stamps
+ */
+
+#pragma once
+
+#include "Types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sw::core
+{
+
+	/**
+	 * @brief Uniform bucket grid indexing unit positions
+	 *
+	 * The bucket edge adapts to the map size so that the bucket table stays
+	 * bounded (about a million buckets) even for very large maps.
+	 */
+	class SpatialIndex
+	{
+	public:
+		/**
+		 * @brief Indexed unit and the cell it occupies
+		 */
+		struct Entry
+		{
+			UnitId id;
+			Position position;
+		};
+
+		/**
+		 * @brief Clear the index and size its bucket grid for a map
+		 * @param width Map width in grid units
+		 * @param height Map height in grid units
+		 */
+		void reset(uint32_t width, uint32_t height);
+
+		/**
+		 * @brief Add a unit to the index
+		 * @param id Unit identifier
+		 * @param position Cell occupied by the unit
+		 */
+		void insert(UnitId id, Position position);
+
+		/**
+		 * @brief Add many units to the index at once
+		 *
+		 * Equivalent to inserting each entry, but every touched bucket and
+		 * region gets a single change stamp.
+		 *
+		 * @param entries Units to add, with the cells they occupy
+		 */
+		void insertBatch(std::span<const Entry> entries);
+
+		/**
+		 * @brief Remove a unit from the index
+		 * @param id Unit identifier
+		 * @param position Cell the unit was indexed at
+		 */
+		void remove(UnitId id, Position position);
+
+		/**
+		 * @brief Remove many units from the index at once
+		 *
+		 * Equivalent to removing each entry, but every touched bucket and
+		 * region gets a single change stamp.
+		 *
+		 * @param entries Units to remove, with the cells they were indexed at
+		 */
+		void removeBatch(std::span<const Entry> entries);
+
+		/**
+		 * @brief Relocate a unit within the index
+		 * @param id Unit identifier
+		 * @param from Cell the unit was indexed at
+		 * @param to New cell
+		 */
+		void move(UnitId id, Position from, Position to);
+
+		/**
+		 * @brief Find the unit indexed at a cell
+		 * @param position Cell to query
+		 * @return Unit identifier, or nullopt if the cell is empty
+		 */
+		[[nodiscard]]
+		auto unitAt(Position position) const -> std::optional<UnitId>;
+
+		/**
+		 * @brief Get the stamp of the most recent change anywhere in the index
+		 * @return Monotonic change counter
+		 */
+		[[nodiscard]]
+		auto changeStamp() const noexcept -> uint64_t
+		{
+			return _clock;
+		}
+
+		/**
+		 * @brief Check whether any unit entered or left the buckets around a cell
+		 *
+		 * The answer is conservative: whole buckets are compared, so a change
+		 * just outside the radius may be reported.
+		 *
+		 * @param center Query centre
+		 * @param radius Chebyshev radius of the region
+		 * @param stamp Stamp obtained from changeStamp() earlier
+		 * @return true if the region may have changed since the stamp
+		 */
+		[[nodiscard]]
+		auto changedSince(Position center, uint32_t radius, uint64_t stamp) const -> bool;
+
+		/**
+		 * @brief Collect the accepted units nearest to a cell
+		 *
+		 * Buckets are visited in rings of increasing distance and the search
+		 * stops as soon as no farther ring can hold a unit as close as the best
+		 * found. Ring stretches lying in empty blocks of buckets are skipped
+		 * from per-block unit counts, so the cost depends on the distance to the
+		 * nearest unit and the local density rather than on the total number
+		 * of units.
+		 *
+		 * The best distance and result list are shared with the caller, so
+		 * several indexes can be searched for one overall nearest set.
+		 *
+		 * @param center Query centre
+		 * @param accept Predicate taking `const Entry&`; rejected entries are ignored
+		 * @param nearest Entries at the best distance found so far (cleared when it improves)
+		 * @param bestDist Best distance found so far (UINT32_MAX if none)
+		 */
+		template <class TAccept>
+		void collectNearest(Position center, TAccept&& accept, std::vector<Entry>& nearest, uint32_t& bestDist) const
+		{
+			if (_buckets.empty() || !center.isWithin(_width, _height))
+			{
+				return;
+			}
+
+			const uint32_t cbx = center.x / _bucketSize;
+			const uint32_t cby = center.y / _bucketSize;
+			const auto bucketsY = static_cast<uint32_t>(_buckets.size() / _bucketsX);
+			const uint32_t lastRing = std::max({cbx, _bucketsX - 1 - cbx, cby, bucketsY - 1 - cby});
+
+			auto visit = [&](uint32_t bx, uint32_t by)
+			{
+				for (const Entry& entry : _buckets[(static_cast<size_t>(by) * _bucketsX) + bx])
+				{
+					const uint32_t dist = center.distanceTo(entry.position);
+					if (dist > bestDist || !accept(entry))
+					{
+						continue;
+					}
+					if (dist < bestDist)
+					{
+						bestDist = dist;
+						nearest.clear();
+					}
+					nearest.push_back(entry);
+				}
+			};
+			// Walk a straight run of buckets, jumping over the parts inside empty blocks
+			auto visitRun = [&](uint32_t bx, uint32_t by, uint32_t last, bool alongX)
+			{
+				uint32_t& step = alongX ? bx : by;
+				while (step <= last)
+				{
+					if (_blockCounts[(static_cast<size_t>(by / BlockSpan) * _blocksX) + (bx / BlockSpan)] == 0)
+					{
+						step = ((step / BlockSpan) + 1) * BlockSpan;
+						continue;
+					}
+					visit(bx, by);
+					++step;
+				}
+			};
+
+			for (uint32_t ring = 0; ring <= lastRing; ++ring)
+			{
+				// Cells in this ring are at least (ring - 1) whole buckets away
+				if (ring > 0 && uint64_t{bestDist} <= uint64_t{ring - 1} * _bucketSize)
+				{
+					return;
+				}
+
+				const bool hasTop = cby >= ring;
+				const bool hasBottom = ring > 0 && cby + ring < bucketsY;
+				const uint32_t minBx = cbx >= ring ? cbx - ring : 0U;
+				const uint32_t maxBx = std::min(_bucketsX - 1, cbx + ring);
+				if (hasTop)
+				{
+					visitRun(minBx, cby - ring, maxBx, true);
+				}
+				if (hasBottom)
+				{
+					visitRun(minBx, cby + ring, maxBx, true);
+				}
+				if (ring == 0)
+				{
+					continue;
+				}
+
+				const uint32_t firstBy = hasTop ? cby - ring + 1 : 0U;
+				const uint32_t lastBy = hasBottom ? cby + ring - 1 : bucketsY - 1;
+				if (cbx >= ring)
+				{
+					visitRun(cbx - ring, firstBy, lastBy, false);
+				}
+				if (cbx + ring < _bucketsX)
+				{
+					visitRun(cbx + ring, firstBy, lastBy, false);
+				}
+			}
+		}
+
+		/**
+		 * @brief Visit every unit within a Chebyshev radius of a cell
+		 * @param center Query centre
+		 * @param radius Maximum distance (inclusive)
+		 * @param visitor Callable taking `const Entry&`
+		 */
+		template <class TVisitor>
+		void forEachInRange(Position center, uint32_t radius, TVisitor&& visitor) const
+		{
+			if (_buckets.empty())
+			{
+				return;
+			}
+
+			const uint32_t minX = center.x > radius ? center.x - radius : 0U;
+			const uint32_t minY = center.y > radius ? center.y - radius : 0U;
+			const auto maxX = static_cast<uint32_t>(std::min<uint64_t>(_width - 1, uint64_t{center.x} + radius));
+			const auto maxY = static_cast<uint32_t>(std::min<uint64_t>(_height - 1, uint64_t{center.y} + radius));
+
+			for (uint32_t by = minY / _bucketSize; by <= maxY / _bucketSize; ++by)
+			{
+				for (uint32_t bx = minX / _bucketSize; bx <= maxX / _bucketSize; ++bx)
+				{
+					for (const Entry& entry : _buckets[(by * _bucketsX) + bx])
+					{
+						if (center.distanceTo(entry.position) <= radius)
+						{
+							visitor(entry);
+						}
+					}
+				}
+			}
+		}
+
+	private:
+		static constexpr uint32_t BlockSpan = 4;  ///< Buckets along each side of an occupancy block
+
+		uint32_t _width{0};					   ///< Map width in grid units
+		uint32_t _height{0};				   ///< Map height in grid units
+		uint32_t _bucketSize{1};			   ///< Bucket edge length in grid units
+		uint32_t _bucketsX{0};				   ///< Number of bucket columns
+		std::vector<std::vector<Entry>> _buckets;  ///< Row-major bucket table
+		uint32_t _regionsX{0};				   ///< Number of region columns
+		std::vector<uint64_t> _stamps;		   ///< Change stamp of each bucket
+		std::vector<uint64_t> _regionStamps;   ///< Change stamp of each square region of buckets
+		uint32_t _blocksX{0};				   ///< Number of occupancy block columns
+		std::vector<uint32_t> _blockCounts;	   ///< Number of units in each square block of buckets
+		uint64_t _clock{0};					   ///< Stamp of the most recent change
+
+		/**
+		 * @brief Get the index of the bucket covering a cell
+		 * @param position Cell inside the map
+		 * @return Row-major bucket index
+		 */
+		[[nodiscard]]
+		auto bucketIndex(Position position) const noexcept -> size_t
+		{
+			return (static_cast<size_t>(position.y / _bucketSize) * _bucketsX) + (position.x / _bucketSize);
+		}
+
+		/**
+		 * @brief Get the index of the occupancy block containing a cell
+		 * @param position Cell inside the map
+		 * @return Row-major block index
+		 */
+		[[nodiscard]]
+		auto blockIndex(Position position) const noexcept -> size_t;
+
+		/**
+		 * @brief Get the bucket covering a cell and mark it changed
+		 * @param position Cell inside the map
+		 * @return Reference to the bucket's entry list
+		 */
+		auto touchBucket(Position position) -> std::vector<Entry>&;
+	};
+
+}
@@ -0,0 +1,49 @@
+/**
+ * @file StateHash.hpp
+ * @brief Hash primitives for incremental world state fingerprinting.
+ *
+ * The world state hash is the XOR of one 64-bit contribution per unit. Because
+ * XOR is its own inverse, a change to a single unit is applied by removing its
+ * old contribution and adding the new one, so the hash never has to be
+ * recomputed from scratch. Two runs that produce the same hash at every turn
+ * have (with overwhelming probability) identical unit ids, positions and HP.
+ */
+
+#pragma once
+
+#include "Types.hpp"
+
+#include <cstdint>
+
+namespace sw::core
+{
+
+	/**
+	 * @brief Finalizer from SplitMix64, used to scatter packed unit state over 64 bits
+	 * @param value Value to mix
+	 * @return Well-distributed 64-bit hash of the value
+	 */
+	[[nodiscard]]
+	constexpr auto mixHash(uint64_t value) noexcept -> uint64_t
+	{
+		value += 0x9E3779B97F4A7C15ULL;
+		value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31U);
+	}
+
+	/**
+	 * @brief Contribution of a single unit to the world state hash
+	 * @param id Unit identifier
+	 * @param position Unit position
+	 * @param hp Current hit points
+	 * @return 64-bit contribution to be XORed into the world hash
+	 */
+	[[nodiscard]]
+	constexpr auto unitStateHash(UnitId id, Position position, HealthPoints hp) noexcept -> uint64_t
+	{
+		const uint64_t where = (static_cast<uint64_t>(position.x) << 32U) | position.y;
+		return mixHash(mixHash(id ^ (static_cast<uint64_t>(hp) << 32U)) ^ where);
+	}
+
+}
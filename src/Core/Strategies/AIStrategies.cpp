@@ -12,54 +12,79 @@ namespace sw::core
 
 	auto SwordsmanAIStrategy::update(Entity& self, World& world, const TurnNumber turn) -> bool
 	{
-		const auto enemies = detail::gatherEnemies(self, world);
-		for (auto* enemy : enemies)
+		if (const auto repeated = _pursuit.repeat(self, world, turn))
 		{
-			if (world.executeAttack(self, *enemy, turn, AttackType::Melee))
-			{
-				return true;
-			}
+			return *repeated;
+		}
+
+		if (world.aiOptions().stickyTargets && _lock.attack(self, world, turn, AttackType::Melee))
+		{
+			_pursuit.forget();
+			return true;
 		}
 
-		if (const Entity* nearest = detail::findNearestEnemy(self, enemies))
+		// Spatial targeting only needs the enemies within reach to attack
+		const bool spatial = detail::usesSpatialTargeting(world);
+		const auto enemies = spatial ? detail::gatherEnemiesInRange(self, world, detail::maxReach(self))
+									 : detail::gatherEnemies(self, world);
+		for (auto* enemy : enemies)
 		{
-			if (world.moveEntityTowards(self, nearest->position(), turn))
+			if (world.executeAttack(self, *enemy, turn, AttackType::Melee))
 			{
+				_lock.lock(*enemy);
+				_pursuit.forget();
 				return true;
 			}
 		}
 
-		return false;
+		const Entity* target = spatial ? detail::findNearestHostile(self, world)
+									   : detail::findNearestEnemy(self, enemies);
+		return detail::pursue(self, world, turn, target, _pursuit);
+	}
+
+	auto SwordsmanAIStrategy::clone() const -> std::unique_ptr<IAIStrategy>
+	{
+		return std::make_unique<SwordsmanAIStrategy>();
 	}
 
 	auto HunterAIStrategy::update(Entity& self, World& world, const TurnNumber turn) -> bool
 	{
-		auto enemies = detail::gatherEnemies(self, world);
-		for (auto* enemy : enemies)
+		if (const auto repeated = _pursuit.repeat(self, world, turn))
 		{
-			if (world.executeAttack(self, *enemy, turn, AttackType::Ranged))
-			{
-				return true;
-			}
+			return *repeated;
 		}
 
-		for (auto* enemy : enemies)
+		if (world.aiOptions().stickyTargets && _lock.attack(self, world, turn, AttackType::Ranged))
 		{
-			if (world.executeAttack(self, *enemy, turn, AttackType::Melee))
-			{
-				return true;
-			}
+			_pursuit.forget();
+			return true;
 		}
 
-		if (const Entity* nearest = detail::findNearestEnemy(self, enemies))
+		// Spatial targeting only needs the enemies within reach to attack
+		const bool spatial = detail::usesSpatialTargeting(world);
+		const auto enemies = spatial ? detail::gatherEnemiesInRange(self, world, detail::maxReach(self))
+									 : detail::gatherEnemies(self, world);
+		for (const AttackType type : {AttackType::Ranged, AttackType::Melee})
 		{
-			if (world.moveEntityTowards(self, nearest->position(), turn))
+			for (auto* enemy : enemies)
 			{
-				return true;
+				if (world.executeAttack(self, *enemy, turn, type))
+				{
+					_lock.lock(*enemy);
+					_pursuit.forget();
+					return true;
+				}
 			}
 		}
 
-		return false;
+		const Entity* target = spatial ? detail::findNearestHostile(self, world)
+									   : detail::findNearestEnemy(self, enemies);
+		return detail::pursue(self, world, turn, target, _pursuit);
+	}
+
+	auto HunterAIStrategy::clone() const -> std::unique_ptr<IAIStrategy>
+	{
+		return std::make_unique<HunterAIStrategy>();
 	}
 
 	// Factory function implementations
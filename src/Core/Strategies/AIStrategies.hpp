@@ -15,9 +15,11 @@
 
 #pragma once
 
+#include "../AI.hpp"
 #include "../Types.hpp"
 
 #include <memory>
+#include <optional>
 
 namespace sw::core
 {
@@ -52,6 +54,52 @@ namespace sw::core
 		 * @return true if an action was taken, false otherwise
 		 */
 		virtual auto update(Entity& self, World& world, TurnNumber turn) -> bool = 0;
+
+		/**
+		 * @brief Create a strategy for a cloned entity (per-unit decision caches start empty)
+		 * @return New strategy of the same kind
+		 */
+		[[nodiscard]]
+		virtual auto clone() const -> std::unique_ptr<IAIStrategy>
+			= 0;
+
+		/**
+		 * @brief Get the enemy kept under sticky targets, for checkpoints
+		 * @return Locked target id, or nullopt if nothing is locked
+		 */
+		[[nodiscard]]
+		virtual auto lockedTarget() const noexcept -> std::optional<UnitId>
+		{
+			return std::nullopt;
+		}
+
+		/**
+		 * @brief Restore the enemy kept under sticky targets from a checkpoint
+		 * @param target Locked target id, or nullopt to release the lock
+		 */
+		virtual void restoreLockedTarget([[maybe_unused]] std::optional<UnitId> target) noexcept {}
+
+		/**
+		 * @brief Get the enemy a cached pursuit step still heads for under incremental AI, for checkpoints
+		 * @param self The entity controlled by this strategy
+		 * @param world The world containing the entity
+		 * @return Cached pursuit target, or nullopt if the next turn evaluates afresh
+		 */
+		[[nodiscard]]
+		virtual auto pursuitTarget([[maybe_unused]] const Entity& self, [[maybe_unused]] const World& world) const
+			-> std::optional<UnitId>
+		{
+			return std::nullopt;
+		}
+
+		/**
+		 * @brief Restore the cached pursuit target from a checkpoint
+		 * @param target Cached pursuit target, or nullopt to evaluate afresh
+		 * @param world The restored world
+		 */
+		virtual void restorePursuitTarget(
+			[[maybe_unused]] std::optional<UnitId> target, [[maybe_unused]] const World& world)
+		{}
 	};
 
 	/**
@@ -79,6 +127,39 @@ namespace sw::core
 		 * @return true if an action was taken, false otherwise
 		 */
 		auto update(Entity& self, World& world, TurnNumber turn) -> bool override;
+
+		/**
+		 * @brief Copy this strategy for a cloned entity
+		 * @return New AI of the same kind with empty decision caches
+		 */
+		[[nodiscard]]
+		auto clone() const -> std::unique_ptr<IAIStrategy> override;
+
+		[[nodiscard]]
+		auto lockedTarget() const noexcept -> std::optional<UnitId> override
+		{
+			return _lock.target();
+		}
+
+		void restoreLockedTarget(std::optional<UnitId> target) noexcept override
+		{
+			_lock.restore(target);
+		}
+
+		[[nodiscard]]
+		auto pursuitTarget(const Entity& self, const World& world) const -> std::optional<UnitId> override
+		{
+			return _pursuit.pending(self, world);
+		}
+
+		void restorePursuitTarget(std::optional<UnitId> target, const World& world) override
+		{
+			_pursuit.restore(target, world);
+		}
+
+	private:
+		detail::PursuitCache _pursuit;  ///< Last pursuit decision, reused while nothing nearby changes
+		detail::TargetLock _lock;		///< Target kept while sticky targets are enabled
 	};
 
 	/**
@@ -107,6 +188,39 @@ namespace sw::core
 		 * @return true if an action was taken, false otherwise
 		 */
 		auto update(Entity& self, World& world, TurnNumber turn) -> bool override;
+
+		/**
+		 * @brief Copy this strategy for a cloned entity
+		 * @return New AI of the same kind with empty decision caches
+		 */
+		[[nodiscard]]
+		auto clone() const -> std::unique_ptr<IAIStrategy> override;
+
+		[[nodiscard]]
+		auto lockedTarget() const noexcept -> std::optional<UnitId> override
+		{
+			return _lock.target();
+		}
+
+		void restoreLockedTarget(std::optional<UnitId> target) noexcept override
+		{
+			_lock.restore(target);
+		}
+
+		[[nodiscard]]
+		auto pursuitTarget(const Entity& self, const World& world) const -> std::optional<UnitId> override
+		{
+			return _pursuit.pending(self, world);
+		}
+
+		void restorePursuitTarget(std::optional<UnitId> target, const World& world) override
+		{
+			_pursuit.restore(target, world);
+		}
+
+	private:
+		detail::PursuitCache _pursuit;  ///< Last pursuit decision, reused while nothing nearby changes
+		detail::TargetLock _lock;		///< Target kept while sticky targets are enabled
 	};
 
 	/**
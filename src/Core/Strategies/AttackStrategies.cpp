@@ -14,9 +14,9 @@ namespace sw::core
 			_damage(damage)
 	{}
 
-	auto MeleeAttackStrategy::attack(Entity& self, Entity& target, World& world, const TurnNumber turn) -> bool
+	auto MeleeAttackStrategy::attack(Entity& self, Entity& target, World& world, const TurnNumber turn) const -> bool
 	{
-		if (!target.isAlive())
+		if (!world.isAlive(target))
 		{
 			return false;
 		}
@@ -71,7 +71,7 @@ namespace sw::core
 					if (occupant.has_value() && *occupant != self.id())
 					{
 						if (const auto* occupantEntity = world.getEntity(*occupant);
-							occupantEntity != nullptr && occupantEntity->isAlive())
+							occupantEntity != nullptr && world.isAlive(*occupantEntity))
 						{
 							return false;
 						}
@@ -82,9 +82,9 @@ namespace sw::core
 		}
 	}
 
-	auto RangedAttackStrategy::attack(Entity& self, Entity& target, World& world, TurnNumber turn) -> bool
+	auto RangedAttackStrategy::attack(Entity& self, Entity& target, World& world, TurnNumber turn) const -> bool
 	{
-		if (!target.isAlive())
+		if (!world.isAlive(target))
 		{
 			return false;
 		}
@@ -124,6 +124,45 @@ namespace sw::core
 		return true;
 	}
 
+	SplashAttackStrategy::SplashAttackStrategy(const SplashConfig& config) :
+			_damage(config.damage),
+			_minRange(config.minRange),
+			_maxRange(std::max(config.minRange, config.maxRange)),
+			_radius(config.radius)
+	{}
+
+	auto SplashAttackStrategy::attack(Entity& self, Entity& target, World& world, const TurnNumber turn) const -> bool
+	{
+		if (!world.isAlive(target) || !self.isHostileTo(target))
+		{
+			return false;
+		}
+
+		const auto targetHealth = target.health();
+		if (targetHealth && !(*targetHealth)->canBeAttackedBy(type()))
+		{
+			return false;
+		}
+
+		const uint32_t dist = self.position().distanceTo(target.position());
+		RangeValue effectiveMinRange = _minRange;
+		RangeValue effectiveMaxRange = _maxRange;
+		if (targetHealth)
+		{
+			effectiveMinRange = (*targetHealth)->getModifiedRange(_minRange, type());
+			effectiveMaxRange = (*targetHealth)->getModifiedRange(_maxRange, type());
+		}
+
+		if (dist < effectiveMinRange || dist > effectiveMaxRange)
+		{
+			return false;
+		}
+
+		world.applyAreaDamage(
+			self, target.position(), _radius, {.damage = static_cast<int>(_damage), .turn = turn}, type());
+		return true;
+	}
+
 	// Factory function implementations
 	auto createMeleeAttack(DamageValue damage) -> std::unique_ptr<IAttackStrategy>
 	{
@@ -143,4 +182,13 @@ namespace sw::core
 			.requireClearAdjacency = requireClearAdjacency});
 	}
 
+
+	auto createSplashAttack(
+		const DamageValue damage, const RangeValue minRange, const RangeValue maxRange, const RangeValue radius)
+		-> std::unique_ptr<IAttackStrategy>
+	{
+		return std::make_unique<SplashAttackStrategy>(SplashAttackStrategy::SplashConfig{
+			.damage = damage, .minRange = minRange, .maxRange = maxRange, .radius = radius});
+	}
+
 }  // namespace sw::core
@@ -4,7 +4,7 @@
  *
  * This file defines the attack strategy system that handles combat interactions
  * between entities in the battle simulation. The strategy pattern allows for
- * different attack types (melee, ranged) with varying damage, range, and
+ * different attack types (melee, ranged, splash) with varying damage, range, and
  * targeting mechanics.
  *
  * Key responsibilities:
@@ -62,7 +62,7 @@ namespace sw::core
 		 * @param turn Current turn number for event logging
 		 * @return true if attack was successful, false otherwise
 		 */
-		virtual auto attack(Entity& self, Entity& target, World& world, TurnNumber turn) -> bool = 0;
+		virtual auto attack(Entity& self, Entity& target, World& world, TurnNumber turn) const -> bool = 0;
 
 		/**
 		 * @brief Get damage value for this attack strategy
@@ -71,6 +71,14 @@ namespace sw::core
 		[[nodiscard]]
 		virtual auto damage() const -> DamageValue
 			= 0;
+
+		/**
+		 * @brief Get the farthest distance at which this attack can hit
+		 * @return Maximum attack distance in grid units
+		 */
+		[[nodiscard]]
+		virtual auto reach() const -> RangeValue
+			= 0;
 	};
 
 	/**
@@ -113,7 +121,7 @@ namespace sw::core
 		 * @param turn Current turn number for event logging
 		 * @return true if attack was successful, false otherwise
 		 */
-		auto attack(Entity& self, Entity& target, World& world, TurnNumber turn) -> bool override;
+		auto attack(Entity& self, Entity& target, World& world, TurnNumber turn) const -> bool override;
 
 		/**
 		 * @brief Get the base damage for this melee attack
@@ -125,6 +133,16 @@ namespace sw::core
 			return _damage;
 		}
 
+		/**
+		 * @brief Melee attacks reach adjacent cells only
+		 * @return 1
+		 */
+		[[nodiscard]]
+		constexpr auto reach() const noexcept -> RangeValue override
+		{
+			return 1;
+		}
+
 	private:
 		DamageValue _damage;  ///< Base damage amount for the melee attack
 	};
@@ -180,7 +198,7 @@ namespace sw::core
 		 * @param turn Current turn number for event logging
 		 * @return true if attack was successful, false otherwise
 		 */
-		auto attack(Entity& self, Entity& target, World& world, TurnNumber turn) -> bool override;
+		auto attack(Entity& self, Entity& target, World& world, TurnNumber turn) const -> bool override;
 
 		/**
 		 * @brief Get the base damage for this ranged attack
@@ -192,6 +210,16 @@ namespace sw::core
 			return _damage;
 		}
 
+		/**
+		 * @brief Ranged attacks reach up to their maximum range
+		 * @return Maximum range in grid units
+		 */
+		[[nodiscard]]
+		constexpr auto reach() const noexcept -> RangeValue override
+		{
+			return _maxRange;
+		}
+
 		// === Range Information ===
 
 		/**
@@ -231,6 +259,118 @@ namespace sw::core
 		bool _requireClearAdjacency;  ///< Whether attack requires clear adjacent squares
 	};
 
+	/**
+	 * @brief Concrete strategy for area-of-effect attacks
+	 *
+	 * Implements a thrown or lobbed attack aimed at a target within range that
+	 * damages every hostile unit within a splash radius of the target's cell.
+	 * Victims are found with a single spatial range query and damaged in one
+	 * batch, so the cost depends on how many units are inside the blast rather
+	 * than on the size of the army.
+	 *
+	 * Features:
+	 * - Configurable minimum and maximum range to the aimed target
+	 * - Chebyshev splash radius around the target cell
+	 * - Never damages the attacker or its allies
+	 * - Power-based damage applied equally to every victim
+	 */
+	class SplashAttackStrategy final : public IAttackStrategy
+	{
+	public:
+		/**
+		 * @brief Splash attack configuration
+		 */
+		struct SplashConfig
+		{
+			DamageValue damage{};
+			RangeValue minRange{};
+			RangeValue maxRange{};
+			RangeValue radius{};
+		};
+
+		/**
+		 * @brief Construct a splash attack strategy
+		 * @param config Damage, range and splash radius of the attack
+		 */
+		explicit SplashAttackStrategy(const SplashConfig& config);
+
+		/**
+		 * @brief Get the attack type
+		 * @return AttackType::Splash
+		 */
+		[[nodiscard]]
+		constexpr auto type() const noexcept -> AttackType override
+		{
+			return AttackType::Splash;
+		}
+
+		/**
+		 * @brief Aim the attack at a target and damage every hostile unit around it
+		 * @param self The entity performing the attack
+		 * @param target The entity the attack is aimed at
+		 * @param world The world containing both entities
+		 * @param turn Current turn number for event logging
+		 * @return true if the attack was made, false if the target is out of range
+		 */
+		auto attack(Entity& self, Entity& target, World& world, TurnNumber turn) const -> bool override;
+
+		/**
+		 * @brief Get the damage dealt to each victim
+		 * @return Damage amount
+		 */
+		[[nodiscard]]
+		constexpr auto damage() const noexcept -> DamageValue override
+		{
+			return _damage;
+		}
+
+		/**
+		 * @brief Splash attacks can be aimed up to their maximum range
+		 * @return Maximum range in grid units
+		 */
+		[[nodiscard]]
+		constexpr auto reach() const noexcept -> RangeValue override
+		{
+			return _maxRange;
+		}
+
+		/**
+		 * @brief Get the minimum distance to the aimed target
+		 * @return Minimum range in grid units
+		 */
+		[[nodiscard]]
+		constexpr auto minRange() const noexcept -> RangeValue
+		{
+			return _minRange;
+		}
+
+		/**
+		 * @brief Get the maximum distance to the aimed target
+		 * @return Maximum range in grid units
+		 */
+		[[nodiscard]]
+		constexpr auto maxRange() const noexcept -> RangeValue
+		{
+			return _maxRange;
+		}
+
+		/**
+		 * @brief Get the splash radius around the target cell
+		 * @return Chebyshev radius in grid units
+		 */
+		[[nodiscard]]
+		constexpr auto radius() const noexcept -> RangeValue
+		{
+			return _radius;
+		}
+
+	private:
+		DamageValue _damage;   ///< Damage dealt to each victim
+		RangeValue _minRange;  ///< Minimum distance to the aimed target
+		RangeValue _maxRange;  ///< Maximum distance to the aimed target
+		RangeValue _radius;	   ///< Splash radius around the target cell
+	};
+
 	/**
 	 * @brief Factory function for creating melee attack strategies
 	 * @param damage Base damage amount for the attack
@@ -250,4 +390,15 @@ namespace sw::core
 		DamageValue damage, RangeValue minRange, RangeValue maxRange, bool requireClearAdjacency = false)
 		-> std::unique_ptr<IAttackStrategy>;
 
+	/**
+	 * @brief Factory function for creating splash attack strategies
+	 * @param damage Damage dealt to each victim
+	 * @param minRange Minimum distance to the aimed target
+	 * @param maxRange Maximum distance to the aimed target
+	 * @param radius Splash radius around the target cell
+	 * @return Unique pointer to splash attack strategy
+	 */
+	auto createSplashAttack(DamageValue damage, RangeValue minRange, RangeValue maxRange, RangeValue radius)
+		-> std::unique_ptr<IAttackStrategy>;
+
 }  // namespace sw::core
@@ -13,16 +13,6 @@ namespace sw::core
 			_hp(static_cast<int>(hp))
 	{}
 
-	auto BasicHealthStrategy::isAlive() const -> bool
-	{
-		return _hp > 0;
-	}
-
-	auto BasicHealthStrategy::hitPoints() const -> HealthPoints
-	{
-		return _hp > 0 ? static_cast<HealthPoints>(_hp) : 0U;
-	}
-
 	void BasicHealthStrategy::applyDamage(int amount)
 	{
 		if (amount <= 0)
@@ -53,6 +43,11 @@ namespace sw::core
 		return originalRange;
 	}
 
+	auto BasicHealthStrategy::clone() const -> std::unique_ptr<IHealthStrategy>
+	{
+		return std::make_unique<BasicHealthStrategy>(hitPoints());
+	}
+
 	// Factory function implementations
 	auto createBasicHealth(HealthPoints hp) -> std::unique_ptr<IHealthStrategy>
 	{
@@ -88,6 +88,14 @@ namespace sw::core
 		[[nodiscard]]
 		virtual auto getModifiedRange(RangeValue originalRange, AttackType attackType) const -> RangeValue
 			= 0;
+
+		/**
+		 * @brief Create an independent copy for a cloned entity
+		 * @return New strategy with the same hit points
+		 */
+		[[nodiscard]]
+		virtual auto clone() const -> std::unique_ptr<IHealthStrategy>
+			= 0;
 	};
 
 	/**
@@ -114,17 +122,27 @@ namespace sw::core
 
 		/**
 		 * @brief Check if the entity is alive
+		 *
+		 * Defined inline so callers that know the concrete type skip the
+		 * virtual dispatch.
+		 *
 		 * @return true if hit points are greater than zero
 		 */
 		[[nodiscard]]
-		auto isAlive() const -> bool override;
+		auto isAlive() const -> bool override
+		{
+			return _hp > 0;
+		}
 
 		/**
 		 * @brief Get the current hit points
 		 * @return Current health points
 		 */
 		[[nodiscard]]
-		auto hitPoints() const -> HealthPoints override;
+		auto hitPoints() const -> HealthPoints override
+		{
+			return _hp > 0 ? static_cast<HealthPoints>(_hp) : 0U;
+		}
 
 		/**
 		 * @brief Apply damage to the entity
@@ -155,6 +173,13 @@ namespace sw::core
 		[[nodiscard]]
 		auto getModifiedRange(RangeValue originalRange, AttackType attackType) const -> RangeValue override;
 
+		/**
+		 * @brief Copy this strategy for a cloned entity
+		 * @return New basic health with the same hit points
+		 */
+		[[nodiscard]]
+		auto clone() const -> std::unique_ptr<IHealthStrategy> override;
+
 	private:
 		int _hp;  ///< Current hit points (can go negative)
 	};
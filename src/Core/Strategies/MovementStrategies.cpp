@@ -55,7 +55,7 @@ namespace sw::core
 			_step(step)
 	{}
 
-	auto TerrainMovementStrategy::move(Entity& self, World& world, Position target, TurnNumber turn) -> bool
+	auto TerrainMovementStrategy::move(Entity& self, World& world, Position target, TurnNumber turn) const -> bool
 	{
 		Position current = self.position();
 		if (current == target || _step == 0U)
@@ -76,6 +76,29 @@ namespace sw::core
 		return world.tryMove(self, target, turn, false);
 	}
 
+	auto TerrainMovementStrategy::predictableTurns(const Position from, const Position target) const -> TurnNumber
+	{
+		if (_step != 1U || from == target)
+		{
+			return 0;
+		}
+		return from.distanceTo(target) - 1;
+	}
+
+	auto TerrainMovementStrategy::predictPosition(const Position from, const Position target, const TurnNumber turns) const
+		-> Position
+	{
+		auto advance = [turns](const uint32_t value, const uint32_t goal) -> uint32_t
+		{
+			if (value < goal)
+			{
+				return value + std::min(turns, goal - value);
+			}
+			return value - std::min(turns, value - goal);
+		};
+		return Position{.x = advance(from.x, target.x), .y = advance(from.y, target.y)};
+	}
+
 	// Factory function implementations
 	auto createTerrainMovement(RangeValue step) -> std::unique_ptr<IMovementStrategy>
 	{
@@ -54,7 +54,7 @@ namespace sw::core
 		 * @param turn Current turn number for event logging
 		 * @return true if movement occurred, false otherwise
 		 */
-		virtual auto move(Entity& self, World& world, Position target, TurnNumber turn) -> bool = 0;
+		virtual auto move(Entity& self, World& world, Position target, TurnNumber turn) const -> bool = 0;
 
 		/**
 		 * @brief Whether this movement type blocks ground movement for other entities
@@ -71,6 +71,37 @@ namespace sw::core
 		[[nodiscard]]
 		virtual auto stepSize() const -> RangeValue
 			= 0;
+
+		/**
+		 * @brief Count the turns of an uncontested march that can be predicted analytically
+		 *
+		 * Used to fast-forward marches far from other units. The default predicts
+		 * nothing, so movement types opt in.
+		 *
+		 * @param from Current position
+		 * @param target March target
+		 * @return Turns the entity keeps moving before the turn it arrives (0 if unpredictable)
+		 */
+		[[nodiscard]]
+		virtual auto predictableTurns([[maybe_unused]] Position from, [[maybe_unused]] Position target) const
+			-> TurnNumber
+		{
+			return 0;
+		}
+
+		/**
+		 * @brief Predict the position after a number of uncontested march turns
+		 * @param from Current position
+		 * @param target March target
+		 * @param turns Number of turns, at most predictableTurns(from, target)
+		 * @return Position the entity reaches
+		 */
+		[[nodiscard]]
+		virtual auto predictPosition(Position from, [[maybe_unused]] Position target, [[maybe_unused]] TurnNumber turns)
+			const -> Position
+		{
+			return from;
+		}
 	};
 
 	/**
@@ -104,7 +135,7 @@ namespace sw::core
 		 * @param turn Current turn number for event logging
 		 * @return true if movement occurred, false otherwise
 		 */
-		auto move(Entity& self, World& world, Position target, TurnNumber turn) -> bool override;
+		auto move(Entity& self, World& world, Position target, TurnNumber turn) const -> bool override;
 
 		/**
 		 * @brief Terrain movement blocks ground for other entities
@@ -126,6 +157,29 @@ namespace sw::core
 			return _step;
 		}
 
+		/**
+		 * @brief Count predictable march turns (single-step movement only)
+		 *
+		 * With a step of one cell each axis closes in by one cell per turn, so
+		 * the march is a closed-form function of the turn count.
+		 *
+		 * @param from Current position
+		 * @param target March target
+		 * @return Turns before the arrival turn, or 0 for larger steps
+		 */
+		[[nodiscard]]
+		auto predictableTurns(Position from, Position target) const -> TurnNumber override;
+
+		/**
+		 * @brief Predict the position after a number of uncontested march turns
+		 * @param from Current position
+		 * @param target March target
+		 * @param turns Number of turns, at most predictableTurns(from, target)
+		 * @return Position the entity reaches
+		 */
+		[[nodiscard]]
+		auto predictPosition(Position from, Position target, TurnNumber turns) const -> Position override;
+
 	private:
 		RangeValue _step;  ///< Maximum distance this movement can travel in one step
 	};
@@ -14,6 +14,7 @@
 #include <cstdint>	// For uint32_t, std::uint8_t
 #include <cstdlib>
 #include <functional>
+#include <string_view>
 
 namespace sw::core
 {
@@ -31,7 +32,26 @@ namespace sw::core
 	using AgilityValue = uint32_t;	 ///< Agility attribute for ranged combat and movement
 	using RangeValue = uint32_t;	 ///< Attack range for ranged weapons
 	using DamageValue = uint32_t;	 ///< Damage amount for attacks and combat
+	using PowerValue = uint32_t;	 ///< Power attribute for area attack damage
 	using TurnNumber = uint32_t;	 ///< Turn number for simulation tracking
+	using FactionId = uint32_t;		 ///< Team a unit fights for
+
+	/**
+	 * @brief Faction of units that fight everyone, including each other
+	 */
+	constexpr FactionId NoFaction = 0;
+
+	/**
+	 * @brief Check whether units of two factions fight each other
+	 * @param lhs Faction of the first unit
+	 * @param rhs Faction of the second unit
+	 * @return true unless both units belong to the same non-zero faction
+	 */
+	[[nodiscard]]
+	constexpr auto areHostile(FactionId lhs, FactionId rhs) noexcept -> bool
+	{
+		return lhs == NoFaction || rhs == NoFaction || lhs != rhs;
+	}
 
 	/**
 	 * @brief Damage calculation types for different combat mechanics
@@ -55,8 +75,9 @@ namespace sw::core
 	 */
 	enum class AttackType : std::uint8_t
 	{
-		Melee,	///< Close-range combat attack
-		Ranged	///< Long-range combat attack
+		Melee,	 ///< Close-range combat attack
+		Ranged,	 ///< Long-range combat attack
+		Splash	 ///< Long-range attack damaging every hostile unit around the target
 	};
 
 	/**
@@ -120,14 +141,31 @@ namespace sw::core
 		}
 	};
 
+	/**
+	 * @brief Read-only snapshot row describing one unit for external consumers
+	 *
+	 * The World keeps one row per unit in turn order and updates it in place on
+	 * spawn, move and damage, so bulk readers (visualisers, analytics) can scan
+	 * the whole state as a contiguous span without per-unit lookups or copies.
+	 */
+	struct UnitState
+	{
+		UnitId id{};		   ///< Unit identifier
+		uint32_t x{};		   ///< Horizontal coordinate
+		uint32_t y{};		   ///< Vertical coordinate
+		HealthPoints hp{};	   ///< Current hit points (0 for units awaiting removal)
+		std::string_view type;	///< Unit type name, owned by the entity
+		FactionId faction{};   ///< Team the unit fights for (NoFaction fights everyone)
+	};
+
 }
 
 /**
  * @brief Hash specialization for Position to enable use in unordered containers
  *
  * Provides a hash function for Position objects, allowing them to be used as keys
- * in std::unordered_map and std::unordered_set. Uses a simple XOR-based hash
- * combining the x and y coordinates.
+ * in std::unordered_map and std::unordered_set. Both coordinates are packed into
+ * one 64-bit key so that every cell of a dense block hashes differently.
  */
 template <>
 struct std::hash<sw::core::Position>
@@ -139,6 +177,6 @@ struct std::hash<sw::core::Position>
 	 */
 	auto operator()(const sw::core::Position& pos) const noexcept -> size_t
 	{
-		return std::hash<uint32_t>{}(pos.x) ^ (std::hash<uint32_t>{}(pos.y) << 1);
+		return std::hash<uint64_t>{}((uint64_t{pos.x} << 32U) | pos.y);
 	}
 };
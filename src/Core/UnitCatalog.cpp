@@ -0,0 +1,373 @@
+#include "UnitCatalog.hpp"
+
+#include "Checkpoint.hpp"
+#include "Entity.hpp"
+#include "Prefabs.hpp"
+#include "Strategies/AIStrategies.hpp"
+#include "Strategies/AttackStrategies.hpp"
+#include "Strategies/HealthStrategies.hpp"
+#include "Strategies/MovementStrategies.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace sw::core
+{
+	namespace
+	{
+		auto makeAttack(
+			AttackType type,
+			DamageValue damage,
+			RangeValue minRange,
+			RangeValue maxRange,
+			RangeValue radius,
+			bool requireClearAdjacency) -> std::unique_ptr<IAttackStrategy>
+		{
+			switch (type)
+			{
+				case AttackType::Melee:
+					return createMeleeAttack(damage);
+				case AttackType::Ranged:
+					return createRangedAttack(damage, minRange, maxRange, requireClearAdjacency);
+				case AttackType::Splash:
+					return createSplashAttack(damage, minRange, maxRange, radius);
+			}
+			throw std::runtime_error("Unknown attack type");
+		}
+
+		auto makeAI(CatalogAI ai) -> std::unique_ptr<IAIStrategy>
+		{
+			switch (ai)
+			{
+				case CatalogAI::Swordsman:
+					return createSwordsmanAI();
+				case CatalogAI::Hunter:
+					return createHunterAI();
+				case CatalogAI::None:
+					break;
+			}
+			return nullptr;
+		}
+
+		// Builds one entity; health and attacks are supplied already resolved
+		template <class TAttackAt>
+		auto assemble(
+			const UnitTemplate& unitTemplate,
+			UnitId id,
+			Position pos,
+			std::optional<HealthPoints> hp,
+			TAttackAt&& attackAt) -> std::unique_ptr<Entity>
+		{
+			auto entity = std::make_unique<Entity>(id, pos, unitTemplate.typeName);
+			if (hp)
+			{
+				entity->setHealth(createBasicHealth(*hp));
+			}
+			if (unitTemplate.movementStep)
+			{
+				entity->setMovement(createTerrainMovement(*unitTemplate.movementStep));
+			}
+			for (size_t i = 0; i < unitTemplate.attacks.size(); ++i)
+			{
+				entity->addAttack(attackAt(i));
+			}
+			if (auto ai = makeAI(unitTemplate.ai))
+			{
+				entity->setAI(std::move(ai));
+			}
+			return entity;
+		}
+
+		// Parses one catalog entry at a time, reporting errors with the line they occur on
+		class CatalogParser
+		{
+		private:
+			std::istream& _input;
+			size_t _line{0};
+			std::istringstream _tokens;
+
+		public:
+			explicit CatalogParser(std::istream& input) :
+					_input(input)
+			{}
+
+			// Advances to the next non-blank, non-comment line; returns false at end of input
+			auto nextLine() -> bool
+			{
+				std::string text;
+				while (std::getline(_input, text))
+				{
+					++_line;
+					if (text.rfind("//", 0) == 0)
+					{
+						continue;
+					}
+					_tokens = std::istringstream(text);
+					if (_tokens >> std::ws; _tokens.peek() != std::char_traits<char>::eof())
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			auto token() -> std::string
+			{
+				std::string word;
+				_tokens >> word;
+				return word;
+			}
+
+			auto requireToken(const char* what) -> std::string
+			{
+				auto word = token();
+				if (word.empty())
+				{
+					fail(std::string("expected ") + what);
+				}
+				return word;
+			}
+
+			void expectEnd()
+			{
+				if (const auto extra = token(); !extra.empty())
+				{
+					fail("unexpected '" + extra + "'");
+				}
+			}
+
+			auto value(const UnitTemplate& unitTemplate, const char* what) -> CatalogValue
+			{
+				const auto word = requireToken(what);
+				uint32_t number = 0;
+				const auto* end = word.data() + word.size();
+				if (const auto [ptr, error] = std::from_chars(word.data(), end, number);
+					error == std::errc{} && ptr == end)
+				{
+					return {.value = number, .fromStat = false};
+				}
+
+				const auto stat = std::ranges::find(unitTemplate.stats, word);
+				if (stat == unitTemplate.stats.end())
+				{
+					fail("'" + word + "' is neither a number nor a stat of " + unitTemplate.typeName);
+				}
+				return {.value = static_cast<uint32_t>(stat - unitTemplate.stats.begin()), .fromStat = true};
+			}
+
+			auto entry() -> UnitTemplate
+			{
+				if (token() != "UNIT")
+				{
+					fail("expected UNIT");
+				}
+
+				UnitTemplate unitTemplate;
+				unitTemplate.typeName = requireToken("a type name");
+				// Checkpoints resolve built-in names before consulting the catalog
+				if (findPrefabType(unitTemplate.typeName) != nullptr)
+				{
+					fail(unitTemplate.typeName + " is a built-in unit type");
+				}
+				for (auto stat = token(); !stat.empty(); stat = token())
+				{
+					if (std::ranges::find(unitTemplate.stats, stat) != unitTemplate.stats.end())
+					{
+						fail("duplicate stat " + stat);
+					}
+					unitTemplate.stats.push_back(std::move(stat));
+				}
+
+				while (true)
+				{
+					if (!nextLine())
+					{
+						fail("missing END for " + unitTemplate.typeName);
+					}
+
+					const auto keyword = token();
+					if (keyword == "END")
+					{
+						expectEnd();
+						return unitTemplate;
+					}
+					if (keyword == "HEALTH")
+					{
+						unitTemplate.health = value(unitTemplate, "hit points");
+					}
+					else if (keyword == "MOVEMENT")
+					{
+						const auto step = value(unitTemplate, "a movement step");
+						if (step.fromStat)
+						{
+							fail("the movement step must be a number");
+						}
+						unitTemplate.movementStep = step.value;
+					}
+					else if (keyword == "ATTACK")
+					{
+						unitTemplate.attacks.push_back(attack(unitTemplate));
+					}
+					else if (keyword == "AI")
+					{
+						const auto name = requireToken("an AI name");
+						if (name == "SWORDSMAN")
+						{
+							unitTemplate.ai = CatalogAI::Swordsman;
+						}
+						else if (name == "HUNTER")
+						{
+							unitTemplate.ai = CatalogAI::Hunter;
+						}
+						else
+						{
+							fail("unknown AI " + name);
+						}
+					}
+					else
+					{
+						fail("unknown component " + keyword);
+					}
+					expectEnd();
+				}
+			}
+
+			[[noreturn]]
+			void fail(const std::string& message) const
+			{
+				throw std::runtime_error("Unit catalog line " + std::to_string(_line) + ": " + message);
+			}
+
+		private:
+			auto attack(const UnitTemplate& unitTemplate) -> UnitTemplate::AttackRecipe
+			{
+				UnitTemplate::AttackRecipe recipe;
+				const auto kind = requireToken("an attack type");
+				if (kind == "MELEE")
+				{
+					recipe.type = AttackType::Melee;
+					recipe.damage = value(unitTemplate, "damage");
+					return recipe;
+				}
+
+				if (kind != "RANGED" && kind != "SPLASH")
+				{
+					fail("unknown attack type " + kind);
+				}
+				recipe.type = kind == "RANGED" ? AttackType::Ranged : AttackType::Splash;
+				recipe.damage = value(unitTemplate, "damage");
+				recipe.minRange = value(unitTemplate, "a minimum range");
+				recipe.maxRange = value(unitTemplate, "a maximum range");
+				if (recipe.type == AttackType::Splash)
+				{
+					recipe.radius = value(unitTemplate, "a splash radius");
+				}
+				else if (_tokens >> std::ws; _tokens.peek() != std::char_traits<char>::eof())
+				{
+					if (token() != "CLEAR")
+					{
+						fail("expected CLEAR");
+					}
+					recipe.requireClearAdjacency = true;
+				}
+				return recipe;
+			}
+		};
+	}
+
+	auto UnitTemplate::instantiate(UnitId id, Position pos, std::span<const uint32_t> values) const
+		-> std::unique_ptr<Entity>
+	{
+		std::optional<HealthPoints> hp;
+		if (health)
+		{
+			hp = health->resolve(values);
+		}
+		return assemble(
+			*this,
+			id,
+			pos,
+			hp,
+			[this, values](size_t i)
+			{
+				const auto& recipe = attacks[i];
+				return makeAttack(
+					recipe.type,
+					recipe.damage.resolve(values),
+					recipe.minRange.resolve(values),
+					recipe.maxRange.resolve(values),
+					recipe.radius.resolve(values),
+					recipe.requireClearAdjacency);
+			});
+	}
+
+	auto UnitTemplate::restore(const CheckpointUnit& unit) const -> std::unique_ptr<Entity>
+	{
+		const bool matches = std::ranges::equal(
+			unit.attacks, attacks, {}, &CheckpointAttack::type, &AttackRecipe::type);
+		if (!matches)
+		{
+			throw std::runtime_error(
+				"Checkpoint unit " + std::to_string(unit.id) + " does not match catalog type " + typeName);
+		}
+
+		std::optional<HealthPoints> hp;
+		if (health)
+		{
+			hp = unit.hp;
+		}
+		return assemble(
+			*this,
+			unit.id,
+			unit.position,
+			hp,
+			[this, &unit](size_t i)
+			{
+				const auto& record = unit.attacks[i];
+				return makeAttack(
+					record.type,
+					record.damage,
+					record.minRange,
+					record.maxRange,
+					record.radius,
+					record.requireClearAdjacency);
+			});
+	}
+
+	void UnitCatalog::load(std::istream& input)
+	{
+		CatalogParser parser(input);
+		while (parser.nextLine())
+		{
+			auto unitTemplate = parser.entry();
+			if (_templates.contains(unitTemplate.typeName))
+			{
+				parser.fail("duplicate unit type " + unitTemplate.typeName);
+			}
+			auto name = unitTemplate.typeName;
+			_templates.emplace(std::move(name), std::move(unitTemplate));
+		}
+	}
+
+	void UnitCatalog::loadFile(const std::filesystem::path& path)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			throw std::runtime_error("Failed to open unit catalog: " + path.string());
+		}
+		load(file);
+	}
+
+	auto UnitCatalog::find(const std::string& typeName) const -> const UnitTemplate*
+	{
+		const auto it = _templates.find(typeName);
+		return it != _templates.end() ? &it->second : nullptr;
+	}
+
+}
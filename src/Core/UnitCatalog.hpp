@@ -0,0 +1,170 @@
+/**
+ * @file UnitCatalog.hpp
+ * @brief Data-driven unit types assembled from the existing strategy building blocks.
+ *
+ * A unit catalog is a text file describing unit types without C++ changes.
+ * Each entry names the type, declares the stats a spawn command supplies and
+ * lists the components to attach, with every number given either as a literal
+ * or as the name of one of the declared stats:
+ *
+ * @code
+ * // Stationary tower shooting at anything 2 to range cells away
+ * UNIT Tower hp power range
+ * HEALTH hp
+ * ATTACK RANGED power 2 range
+ * AI HUNTER
+ * END
+ * @endcode
+ *
+ * Supported lines inside an entry:
+ * - `HEALTH <hp>`: basic health
+ * - `MOVEMENT <step>`: terrain movement (the step must be a literal)
+ * - `ATTACK MELEE <damage>`
+ * - `ATTACK RANGED <damage> <minRange> <maxRange> [CLEAR]`: CLEAR requires free adjacent cells
+ * - `ATTACK SPLASH <damage> <minRange> <maxRange> <radius>`
+ * - `AI SWORDSMAN|HUNTER`
+ *
+ * Attacks are tried in the order listed. Entries are parsed once into
+ * templates whose stat references are resolved to slot indices, so spawning
+ * from a template only substitutes numbers.
+ *
+ * Key responsibilities:
+ * - Parsing and validating catalog files
+ * - Template lookup by type name
+ * - Entity assembly from spawn stats or from checkpoint records
+ */
+
+#pragma once
+
+#include "Core/Types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sw::core
+{
+
+	class Entity;
+	struct CheckpointUnit;
+
+	/**
+	 * @brief Catalog number: a literal or a reference to a spawn stat
+	 */
+	struct CatalogValue
+	{
+		uint32_t value{};		///< Literal value, or stat index when fromStat is set
+		bool fromStat = false;	///< Whether value indexes the spawn stats
+
+		/**
+		 * @brief Resolve the value against a spawn's stats
+		 * @param stats Stat values in schema order
+		 * @return Literal or referenced stat
+		 */
+		[[nodiscard]]
+		auto resolve(std::span<const uint32_t> stats) const noexcept -> uint32_t
+		{
+			return fromStat ? stats[value] : value;
+		}
+	};
+
+	/**
+	 * @brief AI behaviour a catalog unit is driven by
+	 */
+	enum class CatalogAI : std::uint8_t
+	{
+		None,		///< No autonomous behaviour (only marches)
+		Swordsman,	///< Swordsman AI: melee the nearest enemy
+		Hunter		///< Hunter AI: try attacks in order, then pursue
+	};
+
+	/**
+	 * @brief Precompiled unit type from a catalog entry
+	 */
+	class UnitTemplate
+	{
+	public:
+		/**
+		 * @brief Attack component with its numbers still unresolved
+		 */
+		struct AttackRecipe
+		{
+			AttackType type{AttackType::Melee};
+			CatalogValue damage;
+			CatalogValue minRange;
+			CatalogValue maxRange;
+			CatalogValue radius;
+			bool requireClearAdjacency = false;
+		};
+
+		std::string typeName;				   ///< Type name reported in events
+		std::vector<std::string> stats;		   ///< Stat names in the order spawn commands supply them
+		std::optional<CatalogValue> health;	   ///< Initial HP, if the unit can be damaged
+		std::optional<RangeValue> movementStep;  ///< Terrain movement step, if the unit moves
+		std::vector<AttackRecipe> attacks;	   ///< Attacks in the order they are tried
+		CatalogAI ai{CatalogAI::None};		   ///< Autonomous behaviour
+
+		/**
+		 * @brief Build a unit of this type
+		 * @param id Unique identifier for the unit
+		 * @param pos Initial position on the map
+		 * @param values Stat values in schema order (exactly stats.size() of them)
+		 * @return Newly created entity
+		 */
+		[[nodiscard]]
+		auto instantiate(UnitId id, Position pos, std::span<const uint32_t> values) const
+			-> std::unique_ptr<Entity>;
+
+		/**
+		 * @brief Rebuild a unit of this type from a checkpoint record
+		 *
+		 * Current HP and the recorded attack numbers replace the template's, so
+		 * the unit resumes exactly as it was captured.
+		 *
+		 * @param unit Checkpoint record of a unit of this type
+		 * @return Newly created entity
+		 * @throws std::runtime_error if the recorded attacks do not match the template
+		 */
+		[[nodiscard]]
+		auto restore(const CheckpointUnit& unit) const -> std::unique_ptr<Entity>;
+	};
+
+	/**
+	 * @brief Unit templates loaded from catalog files, looked up by type name
+	 */
+	class UnitCatalog
+	{
+	public:
+		/**
+		 * @brief Parse catalog entries and add them to the catalog
+		 * @param input Catalog text
+		 * @throws std::runtime_error on syntax errors, unknown stats or duplicate type names
+		 */
+		void load(std::istream& input);
+
+		/**
+		 * @brief Parse a catalog file and add its entries to the catalog
+		 * @param path Catalog file
+		 * @throws std::runtime_error if the file cannot be read or is invalid
+		 */
+		void loadFile(const std::filesystem::path& path);
+
+		/**
+		 * @brief Find the template of a unit type
+		 * @param typeName Type name as written in the catalog
+		 * @return Template (stable for the catalog's lifetime), or nullptr if unknown
+		 */
+		[[nodiscard]]
+		auto find(const std::string& typeName) const -> const UnitTemplate*;
+
+	private:
+		std::unordered_map<std::string, UnitTemplate> _templates;  ///< Templates by type name
+	};
+
+}
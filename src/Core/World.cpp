@@ -1,6 +1,8 @@
 #include "World.hpp"
 
+#include "Core/AI.hpp"
 #include "Core/Entity.hpp"
+#include "Core/StateHash.hpp"
 #include "Core/Types.hpp"
 #include "IO/Events/MapCreated.hpp"
 #include "IO/Events/UnitAttacked.hpp"
@@ -9,10 +11,15 @@
 #include "IO/Events/UnitSpawned.hpp"
 #include "IO/System/EventLog.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -31,19 +38,50 @@ namespace sw::core
 
 	void World::reset(const uint32_t width, const uint32_t height, std::unique_ptr<EventLog> log)
 	{
-		_map = Map({.width = width, .height = height});
+		_map.reset({.width = width, .height = height});
 		_entities.clear();
 		_entityOrder.clear();
-		_eventLog = std::move(log);
+		_unitStates.clear();
+		_slotEntities.clear();
 		_pendingRemoval.clear();
-		if (!_eventLog)
+		_damageBuffer.clear();
+		_stateHash = 0;
+		_livingUnits = 0;
+		_lastDamageTurn = 0;
+		if (log || !_eventLog)
 		{
-			_eventLog = std::make_unique<EventLog>();
+			_eventLog = log ? std::move(log) : std::make_unique<EventLog>();
 		}
 
 		logMapCreated({.width = width, .height = height});
 	}
 
+	void World::restore(
+		const Map::Dimensions& dimensions,
+		std::vector<std::unique_ptr<Entity>> entities,
+		std::unique_ptr<EventLog> log)
+	{
+		_map.reset(dimensions);
+		_entities.clear();
+		_entityOrder.clear();
+		_unitStates.clear();
+		_slotEntities.clear();
+		_pendingRemoval.clear();
+		_damageBuffer.clear();
+		_stateHash = 0;
+		_livingUnits = 0;
+		_lastDamageTurn = 0;
+		if (log || !_eventLog)
+		{
+			_eventLog = log ? std::move(log) : std::make_unique<EventLog>();
+		}
+
+		if (!insertEntities(entities))
+		{
+			throw std::runtime_error("failed to place restored entity on map");
+		}
+	}
+
 	auto World::getEntity(const UnitId id) -> Entity*
 	{
 		const auto it = _entities.find(id);
@@ -56,7 +94,7 @@ namespace sw::core
 		return (it != _entities.end()) ? it->second.get() : nullptr;
 	}
 
-	auto World::addEntity(std::unique_ptr<Entity> entity) -> Entity&
+	auto World::addEntity(std::unique_ptr<Entity> entity, const TurnNumber turn) -> Entity&
 	{
 		if (!entity)
 		{
@@ -66,36 +104,108 @@ namespace sw::core
 		UnitId id = entity->id();
 		const Position pos = entity->position();
 
-		if (!_map.placeUnit(id, pos, entity->blocksGround()))
+		if (!_map.placeUnit(id, pos, entity->blocksGround(), entity->faction()))
 		{
 			throw std::runtime_error("failed to place entity on map");
 		}
 
-		const std::string typeName = entity->typeName();
+		_stateHash ^= stateContribution(*entity);
 		Entity& stored = *_entities.emplace(id, std::move(entity)).first->second;
-		_entityOrder.push_back(id);
+		appendToOrder(stored);
 
-		io::UnitSpawned event;
-		event.unitId = id;
-		event.unitType = typeName;
-		event.x = pos.x;
-		event.y = pos.y;
-		eventLog().log(1, event);
+		if (eventLog().wants<io::UnitSpawned>())
+		{
+			io::UnitSpawned event;
+			event.unitId = id;
+			event.unitType = stored.typeName();
+			event.x = pos.x;
+			event.y = pos.y;
+			eventLog().log(turn, event);
+		}
 
 		return stored;
 	}
 
+	auto World::addEntities(std::vector<std::unique_ptr<Entity>> entities, const TurnNumber turn) -> bool
+	{
+		if (std::ranges::any_of(entities, [](const auto& entity) { return entity == nullptr; }))
+		{
+			throw std::invalid_argument("entity must not be null");
+		}
+		if (!insertEntities(entities))
+		{
+			return false;
+		}
+		if (!eventLog().wants<io::UnitSpawned>())
+		{
+			return true;
+		}
+
+		const auto added = std::span(_entityOrder).last(entities.size());
+		for (const UnitId id : added)
+		{
+			const Entity& entity = *getEntity(id);
+			io::UnitSpawned event;
+			event.unitId = entity.id();
+			event.unitType = entity.typeName();
+			event.x = entity.position().x;
+			event.y = entity.position().y;
+			eventLog().log(turn, event);
+		}
+		return true;
+	}
+
+	auto World::insertEntities(std::vector<std::unique_ptr<Entity>>& entities) -> bool
+	{
+		std::unordered_set<UnitId> ids;
+		ids.reserve(entities.size());
+		std::vector<Map::Placement> placements;
+		placements.reserve(entities.size());
+		for (const auto& entity : entities)
+		{
+			if (_entities.contains(entity->id()) || !ids.insert(entity->id()).second)
+			{
+				return false;
+			}
+			placements.push_back(
+				{.id = entity->id(),
+				 .position = entity->position(),
+				 .blocksGround = entity->blocksGround(),
+				 .faction = entity->faction()});
+		}
+		if (!_map.placeUnits(placements))
+		{
+			return false;
+		}
+
+		reserve(entities.size());
+		for (auto& entity : entities)
+		{
+			const UnitId id = entity->id();
+			_stateHash ^= stateContribution(*entity);
+			appendToOrder(*_entities.emplace(id, std::move(entity)).first->second);
+		}
+		return true;
+	}
+
+	void World::reserve(const size_t additional)
+	{
+		_map.reserve(additional);
+		_entities.reserve(_entities.size() + additional);
+		_entityOrder.reserve(_entityOrder.size() + additional);
+		_unitStates.reserve(_unitStates.size() + additional);
+		_slotEntities.reserve(_slotEntities.size() + additional);
+	}
+
 	void World::removeEntity(UnitId id)
 	{
-		_map.removeUnit(id);
-		_entities.erase(id);
-		std::erase(_entityOrder, id);
-		_pendingRemoval.erase(id);
+		std::erase(_pendingRemoval, id);
+		removeEntities({&id, 1});
 	}
 
 	auto World::tryMove(Entity& entity, Position destination, TurnNumber turn, bool ignoreBlocking) -> bool
 	{
-		if (!entity.isAlive())
+		if (!isAlive(entity))
 		{
 			return false;
 		}
@@ -115,6 +225,25 @@ namespace sw::core
 			return false;
 		}
 
+		if (!relocate(entity, destination))
+		{
+			return false;
+		}
+
+		if (eventLog().wants<io::UnitMoved>())
+		{
+			io::UnitMoved event;
+			event.unitId = entity.id();
+			event.x = destination.x;
+			event.y = destination.y;
+			eventLog().log(turn, event);
+		}
+
+		return true;
+	}
+
+	auto World::relocate(Entity& entity, const Position destination) -> bool
+	{
 		if (!_map.moveUnit(entity.id(), destination))
 		{
 			return false;
@@ -126,14 +255,13 @@ namespace sw::core
 			_map.setPositionBlocked(destination, true);
 		}
 
+		_stateHash ^= stateContribution(entity);
 		entity.setPosition(destination);
+		_stateHash ^= stateContribution(entity);
 
-		io::UnitMoved event;
-		event.unitId = entity.id();
-		event.x = destination.x;
-		event.y = destination.y;
-		eventLog().log(turn, event);
-
+		UnitState& state = _unitStates[entity.slot()];
+		state.x = destination.x;
+		state.y = destination.y;
 		return true;
 	}
 
@@ -155,22 +283,173 @@ namespace sw::core
 			return;
 		}
 
-		(*health)->applyDamage(config.damage);
+		if (inflictDamage(attacker, target, config))
+		{
+			if (eventLog().wants<io::UnitDied>())
+			{
+				sw::io::UnitDied diedEvent;
+				diedEvent.unitId = target.id();
+				eventLog().log(config.turn, diedEvent);
+			}
+			scheduleRemoval(target.id());
+		}
+	}
 
-		io::UnitAttacked event;
-		event.attackerUnitId = attacker.id();
-		event.targetUnitId = target.id();
-		event.damage = config.damage;
-		event.targetHp = (*health)->hitPoints();
-		eventLog().log(config.turn, event);
+	auto World::applyAreaDamage(
+		const Entity& attacker,
+		const Position center,
+		const RangeValue radius,
+		const DamageConfig& config,
+		const AttackType type) -> size_t
+	{
+		if (config.damage <= 0)
+		{
+			return 0;
+		}
 
-		if (!(*health)->isAlive())
+		std::vector<const Entity*> victims;
+		_map.forEachHostileInRange(
+			center,
+			radius,
+			attacker.faction(),
+			[&](const SpatialIndex::Entry& entry)
+			{
+				const auto* victim = getEntity(entry.id);
+				if (victim == nullptr || victim == &attacker || !attacker.isHostileTo(*victim) || !isAlive(*victim))
+				{
+					return;
+				}
+				if (const auto health = victim->health(); health && (*health)->canBeAttackedBy(type))
+				{
+					victims.push_back(victim);
+				}
+			});
+
+		detail::sortInTurnOrder(victims);
+
+		std::vector<UnitId> killed;
+		for (const auto* victim : victims)
 		{
-			sw::io::UnitDied diedEvent;
-			diedEvent.unitId = target.id();
-			eventLog().log(config.turn, diedEvent);
-			scheduleRemoval(target.id());
+			if (inflictDamage(attacker, *victim, config))
+			{
+				killed.push_back(victim->id());
+			}
+		}
+
+		for (const UnitId id : killed)
+		{
+			if (eventLog().wants<io::UnitDied>())
+			{
+				sw::io::UnitDied diedEvent;
+				diedEvent.unitId = id;
+				eventLog().log(config.turn, diedEvent);
+			}
+			scheduleRemoval(id);
+		}
+		return victims.size();
+	}
+
+	auto World::inflictDamage(const Entity& attacker, const Entity& target, const DamageConfig& config) -> bool
+	{
+		if (_damageResolution == DamageResolution::Simultaneous)
+		{
+			// The target keeps fighting until the turn ends
+			_damageBuffer.push_back({.slot = target.slot(), .attacker = attacker.id(), .damage = config.damage});
+			return false;
+		}
+
+		const IHealthStrategy* health = &lowerHealth(target, config.damage);
+		_lastDamageTurn = config.turn;
+
+		if (eventLog().wants<io::UnitAttacked>())
+		{
+			io::UnitAttacked event;
+			event.attackerUnitId = attacker.id();
+			event.targetUnitId = target.id();
+			event.damage = config.damage;
+			event.targetHp = health->hitPoints();
+			eventLog().log(config.turn, event);
 		}
+
+		return !health->isAlive();
+	}
+
+	void World::resolveDamage(const TurnNumber turn)
+	{
+		if (_damageBuffer.empty())
+		{
+			return;
+		}
+
+		// Reduce per target: slots index a dense table, so no sorting is needed
+		_damageTotals.assign(_unitStates.size(), 0);
+		const bool reportHits = eventLog().wants<io::UnitAttacked>();
+		for (const PendingHit& hit : _damageBuffer)
+		{
+			const Entity& target = *_slotEntities[hit.slot];
+			int64_t hp = _unitStates[hit.slot].hp - _damageTotals[hit.slot] - hit.damage;
+			if (target.hasCustomHealth())
+			{
+				// The component may reduce each hit, so it takes them one at a time and reports its own HP
+				hp = lowerHealth(target, hit.damage).hitPoints();
+			}
+			_damageTotals[hit.slot] += hit.damage;
+			if (!reportHits)
+			{
+				continue;
+			}
+
+			io::UnitAttacked event;
+			event.attackerUnitId = hit.attacker;
+			event.targetUnitId = target.id();
+			event.damage = hit.damage;
+			event.targetHp = static_cast<uint32_t>(std::max<int64_t>(0, hp));
+			eventLog().log(turn, event);
+		}
+
+		// Apply each target's total once, in turn order; custom health took its hits above
+		std::vector<UnitId> killed;
+		for (uint32_t slot = 0; slot < _damageTotals.size(); ++slot)
+		{
+			const int64_t total = _damageTotals[slot];
+			if (total == 0)
+			{
+				continue;
+			}
+
+			const Entity& target = *_slotEntities[slot];
+			if (!target.hasCustomHealth())
+			{
+				lowerHealth(target, static_cast<int>(std::min<int64_t>(total, std::numeric_limits<int>::max())));
+			}
+			if (!isAlive(target))
+			{
+				killed.push_back(target.id());
+			}
+		}
+		_damageBuffer.clear();
+		_lastDamageTurn = turn;
+
+		for (const UnitId id : killed)
+		{
+			if (eventLog().wants<io::UnitDied>())
+			{
+				sw::io::UnitDied diedEvent;
+				diedEvent.unitId = id;
+				eventLog().log(turn, diedEvent);
+			}
+			scheduleRemoval(id);
+		}
+	}
+
+	auto World::lowerHealth(const Entity& target, const int amount) -> IHealthStrategy&
+	{
+		IHealthStrategy& health = **target.health();
+		_stateHash ^= stateContribution(target);
+		health.applyDamage(amount);
+		_stateHash ^= stateContribution(target);
+		_unitStates[target.slot()].hp = health.hitPoints();
+		return health;
 	}
 
 	auto World::moveEntityTowards(Entity& entity, Position target, TurnNumber turn) -> bool
@@ -221,6 +500,35 @@ namespace sw::core
 		return false;
 	}
 
+	void World::appendToOrder(Entity& entity)
+	{
+		const auto health = entity.health();
+		const Position pos = entity.position();
+		const HealthPoints hp = health ? (*health)->hitPoints() : 0U;
+
+		entity.setSlot(static_cast<uint32_t>(_unitStates.size()));
+		_entityOrder.push_back(entity.id());
+		_slotEntities.push_back(&entity);
+		_unitStates.push_back(
+			{.id = entity.id(),
+			 .x = pos.x,
+			 .y = pos.y,
+			 .hp = hp,
+			 .type = entity.typeName(),
+			 .faction = entity.faction()});
+		if (isAlive(entity))
+		{
+			++_livingUnits;
+		}
+	}
+
+	auto World::stateContribution(const Entity& entity) -> uint64_t
+	{
+		const auto health = entity.health();
+		const HealthPoints hp = health ? (*health)->hitPoints() : 0U;
+		return unitStateHash(entity.id(), entity.position(), hp);
+	}
+
 	void World::logMapCreated(const Map::Dimensions& dimensions) const
 	{
 		io::MapCreated event;
@@ -231,7 +539,8 @@ namespace sw::core
 
 	void World::scheduleRemoval(UnitId id)
 	{
-		_pendingRemoval.insert(id);
+		--_livingUnits;
+		_pendingRemoval.push_back(id);
 	}
 
 	void World::flushPendingRemovals()
@@ -241,12 +550,64 @@ namespace sw::core
 			return;
 		}
 
-		const std::vector toRemove(_pendingRemoval.begin(), _pendingRemoval.end());
+		removeEntities(_pendingRemoval);
 		_pendingRemoval.clear();
-		for (const UnitId id : toRemove)
+	}
+
+	void World::removeEntities(std::span<const UnitId> ids)
+	{
+		_removedSlots.clear();
+		_removedUnits.clear();
+		for (const UnitId id : ids)
+		{
+			const auto it = _entities.find(id);
+			if (it == _entities.end())
+			{
+				continue;
+			}
+
+			const uint32_t slot = it->second->slot();
+			const UnitState& row = _unitStates[slot];
+			_removedSlots.push_back(slot);
+			_removedUnits.push_back({.id = id, .position = {.x = row.x, .y = row.y}});
+			// Units that died were uncounted when their removal was scheduled
+			if (isAlive(*it->second))
+			{
+				--_livingUnits;
+			}
+			_stateHash ^= stateContribution(*it->second);
+			_entities.erase(it);
+		}
+		if (_removedSlots.empty())
 		{
-			removeEntity(id);
+			return;
+		}
+
+		_map.removeUnits(_removedUnits);
+
+		// Slide survivors down over the removed rows, keeping creation order
+		std::ranges::sort(_removedSlots);
+		auto removed = _removedSlots.begin();
+		size_t write = *removed;
+		for (size_t read = write; read < _entityOrder.size(); ++read)
+		{
+			if (removed != _removedSlots.end() && *removed == read)
+			{
+				++removed;
+				continue;
+			}
+			if (write != read)
+			{
+				_entityOrder[write] = _entityOrder[read];
+				_unitStates[write] = std::move(_unitStates[read]);
+				_slotEntities[write] = _slotEntities[read];
+				_slotEntities[write]->setSlot(static_cast<uint32_t>(write));
+			}
+			++write;
 		}
+		_entityOrder.resize(write);
+		_unitStates.resize(write);
+		_slotEntities.resize(write);
 	}
 
 }
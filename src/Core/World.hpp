@@ -25,8 +25,9 @@
 
 #include <memory>
 #include <optional>
+#include <random>
+#include <span>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 namespace sw::core
@@ -69,11 +70,31 @@ namespace sw::core
 
 		/**
 		 * @brief Reset the world with new dimensions and event log
+		 *
+		 * Containers are cleared rather than replaced, so a World reused across
+		 * scenarios keeps its allocated capacity.
+		 *
 		 * @param width New map width in grid units
 		 * @param height New map height in grid units
-		 * @param log New event log for tracking simulation events
+		 * @param log New event log for tracking simulation events (nullptr keeps the current one)
+		 */
+		void reset(uint32_t width, uint32_t height, std::unique_ptr<sw::EventLog> log = nullptr);
+
+		/**
+		 * @brief Rebuild the world from previously captured state
+		 *
+		 * Unlike reset() and addEntity(), no MAP_CREATED or UNIT_SPAWNED events are
+		 * logged: the restored world continues a simulation that already reported them.
+		 *
+		 * @param dimensions Map dimensions
+		 * @param entities Entities in turn order
+		 * @param log Event log for tracking simulation events (nullptr keeps the current one)
+		 * @throws std::runtime_error if an entity cannot be placed on the map
 		 */
-		void reset(uint32_t width, uint32_t height, std::unique_ptr<sw::EventLog> log);
+		void restore(
+			const Map::Dimensions& dimensions,
+			std::vector<std::unique_ptr<Entity>> entities,
+			std::unique_ptr<sw::EventLog> log = nullptr);
 
 		// === Core System Access ===
 
@@ -106,6 +127,100 @@ namespace sw::core
 			return *_eventLog;
 		}
 
+		/**
+		 * @brief Get the random engine driving AI decisions in this world
+		 *
+		 * Each world owns its engine, so independent simulations can be interleaved
+		 * on one thread without perturbing each other's random streams.
+		 *
+		 * @return Reference to the world's random engine
+		 */
+		auto randomEngine() noexcept -> std::mt19937&
+		{
+			return _random;
+		}
+
+		/**
+		 * @brief Get the random engine driving AI decisions in this world (const)
+		 * @return Const reference to the world's random engine
+		 */
+		[[nodiscard]]
+		auto randomEngine() const noexcept -> const std::mt19937&
+		{
+			return _random;
+		}
+
+		/**
+		 * @brief Optional AI behaviours shared by all strategies in this world
+		 */
+		struct AIOptions
+		{
+			bool incremental = false;	 ///< Reuse pursuit steps while nothing changes nearby
+			bool stickyTargets = false;	 ///< Keep attacking the same target while it stays valid
+		};
+
+		/**
+		 * @brief Set the optional AI behaviours
+		 * @param options Behaviours AI strategies may use
+		 */
+		void setAIOptions(const AIOptions& options) noexcept
+		{
+			_aiOptions = options;
+		}
+
+		/**
+		 * @brief Get the optional AI behaviours
+		 * @return Behaviours AI strategies may use
+		 */
+		[[nodiscard]]
+		auto aiOptions() const noexcept -> const AIOptions&
+		{
+			return _aiOptions;
+		}
+
+		/**
+		 * @brief How hits landed during a turn are applied
+		 */
+		enum class DamageResolution : uint8_t
+		{
+			Sequential,	  ///< Each hit lowers HP immediately; a unit killed mid-turn stops acting
+			Simultaneous  ///< Hits are buffered and applied together at the end of the turn
+		};
+
+		/**
+		 * @brief Select how hits are applied
+		 * @param resolution Damage resolution mode
+		 */
+		void setDamageResolution(DamageResolution resolution) noexcept
+		{
+			_damageResolution = resolution;
+		}
+
+		/**
+		 * @brief Get how hits are applied
+		 * @return Damage resolution mode
+		 */
+		[[nodiscard]]
+		auto damageResolution() const noexcept -> DamageResolution
+		{
+			return _damageResolution;
+		}
+
+		/**
+		 * @brief Apply the hits buffered during a turn in simultaneous resolution
+		 *
+		 * Hits are summed per target into a dense per-slot table (no sorting),
+		 * then each damaged unit's HP is lowered once. Units with a custom health
+		 * component take their hits one at a time instead, since the component
+		 * may reduce each hit. UNIT_ATTACKED events are logged in the order the
+		 * hits were made with the HP each hit left, followed by UNIT_DIED events
+		 * for every unit that fell, in turn order; all deaths are scheduled for
+		 * removal together. Does nothing in sequential resolution.
+		 *
+		 * @param turn Turn the hits were made in
+		 */
+		void resolveDamage(TurnNumber turn);
+
 		/**
 		 * @brief Get the entity turn order (const)
 		 * @return Const reference to the entity order vector
@@ -117,12 +232,83 @@ namespace sw::core
 		}
 
 		/**
-		 * @brief Get the entity turn order for modification
-		 * @return Reference to the entity order vector
+		 * @brief Get a read-only view of every unit's state in turn order
+		 *
+		 * Rows are updated in place on spawn, move and damage, and compacted on
+		 * removal; the span is invalidated by any spawn or removal.
+		 *
+		 * @return Contiguous span of unit state rows, parallel to entityOrder()
 		 */
-		auto entityOrder() noexcept -> std::vector<UnitId>&
+		[[nodiscard]]
+		auto unitStates() const noexcept -> std::span<const UnitState>
 		{
-			return _entityOrder;
+			return _unitStates;
+		}
+
+		/**
+		 * @brief Check whether a unit in this world is alive
+		 *
+		 * Units with BasicHealthStrategy are answered from their dense state
+		 * row with a single load; other health components are asked directly.
+		 *
+		 * @param entity Entity stored in this world
+		 * @return true if the entity is alive
+		 */
+		[[nodiscard]]
+		auto isAlive(const Entity& entity) const -> bool
+		{
+			if (entity.hasCustomHealth())
+			{
+				return entity.isAlive();
+			}
+			return _unitStates[entity.slot()].hp != 0;
+		}
+
+		/**
+		 * @brief Get the number of living units
+		 *
+		 * Counted on spawn, death and removal rather than by scanning, so the
+		 * per-turn end check does not grow with sleeping or idle units.
+		 *
+		 * @return Units in this world for which isAlive() holds
+		 */
+		[[nodiscard]]
+		auto livingUnitCount() const noexcept -> size_t
+		{
+			return _livingUnits;
+		}
+
+		/**
+		 * @brief Get the incremental hash of the world state
+		 *
+		 * Maintained on spawn, move, damage and removal; never recomputed.
+		 * See StateHash.hpp for the hashing scheme.
+		 *
+		 * @return 64-bit fingerprint of every unit's id, position and HP
+		 */
+		[[nodiscard]]
+		auto stateHash() const noexcept -> uint64_t
+		{
+			return _stateHash;
+		}
+
+		/**
+		 * @brief Get the last turn in which any unit took damage
+		 * @return Turn number, or 0 if no damage was dealt since the last reset or restore
+		 */
+		[[nodiscard]]
+		auto lastDamageTurn() const noexcept -> TurnNumber
+		{
+			return _lastDamageTurn;
+		}
+
+		/**
+		 * @brief Set the last damage turn of a world rebuilt by restore()
+		 * @param turn Turn number captured with the world, or 0 if no damage was dealt
+		 */
+		void restoreLastDamageTurn(const TurnNumber turn) noexcept
+		{
+			_lastDamageTurn = turn;
 		}
 
 		// === Entity Management ===
@@ -145,12 +331,35 @@ namespace sw::core
 		/**
 		 * @brief Add an entity to the world
 		 * @param entity Unique pointer to the entity to add
+		 * @param turn Turn at which the UNIT_SPAWNED event is logged
 		 * @return Reference to the added entity
 		 */
-		auto addEntity(std::unique_ptr<Entity> entity) -> Entity&;
+		auto addEntity(std::unique_ptr<Entity> entity, TurnNumber turn = 1) -> Entity&;
+
+		/**
+		 * @brief Add many entities to the world at once
+		 *
+		 * All containers are reserved up front and every placement is checked
+		 * before anything changes; the map's spatial indexes are then built in
+		 * one batch. UNIT_SPAWNED is logged for each entity in order, exactly as
+		 * separate addEntity() calls would.
+		 *
+		 * @param entities Entities to add, in turn order
+		 * @param turn Turn at which the UNIT_SPAWNED events are logged
+		 * @return true if all were added; false (nothing added) if an id is taken or repeated, or a cell
+		 *         is invalid, occupied or repeated
+		 * @throws std::invalid_argument if an entity is null
+		 */
+		auto addEntities(std::vector<std::unique_ptr<Entity>> entities, TurnNumber turn = 1) -> bool;
 
 		/**
-		 * @brief Remove an entity from the world (deferred removal)
+		 * @brief Make room for more entities so that adding them does not reallocate
+		 * @param additional Number of entities about to be added
+		 */
+		void reserve(size_t additional);
+
+		/**
+		 * @brief Remove an entity from the world immediately
 		 * @param id Unit identifier to remove
 		 */
 		void removeEntity(UnitId id);
@@ -159,7 +368,8 @@ namespace sw::core
 		 * @brief Process all pending entity removals
 		 *
 		 * Called at the end of each turn to safely remove entities
-		 * that were marked for removal during the turn.
+		 * that were marked for removal during the turn. The whole batch is
+		 * removed in one pass and the turn order is compacted once.
 		 */
 		void flushPendingRemovals();
 
@@ -175,6 +385,18 @@ namespace sw::core
 		 */
 		auto tryMove(Entity& entity, Position destination, TurnNumber turn, bool ignoreBlocking) -> bool;
 
+		/**
+		 * @brief Move an entity without blocking checks or a UNIT_MOVED event
+		 *
+		 * Keeps the map, state rows and state hash consistent. Used when the
+		 * caller has already established the move is legal and reports it itself.
+		 *
+		 * @param entity Entity to move
+		 * @param destination Target position
+		 * @return true if the map accepted the move
+		 */
+		auto relocate(Entity& entity, Position destination) -> bool;
+
 		/**
 		 * @brief Damage application configuration
 		 */
@@ -192,6 +414,25 @@ namespace sw::core
 		 */
 		void applyDamage(const Entity& attacker, const Entity& target, const DamageConfig& config);
 
+		/**
+		 * @brief Damage every hostile unit within a radius of a cell in one batch
+		 *
+		 * Victims are collected with a single spatial range query and damaged in
+		 * turn order, one UNIT_ATTACKED event each. Units killed by the blast are
+		 * reported and scheduled for removal together once every victim was hit.
+		 * The attacker and its allies are never damaged.
+		 *
+		 * @param attacker Entity dealing damage
+		 * @param center Cell at the centre of the blast
+		 * @param radius Chebyshev radius of the blast
+		 * @param config Damage configuration containing amount and turn
+		 * @param type Attack type victims must be vulnerable to
+		 * @return Number of units damaged
+		 */
+		auto applyAreaDamage(
+			const Entity& attacker, Position center, RangeValue radius, const DamageConfig& config, AttackType type)
+			-> size_t;
+
 		// === High-Level AI Actions ===
 
 		/**
@@ -237,11 +478,33 @@ namespace sw::core
 		}
 
 	private:
+		/**
+		 * @brief Hit buffered for simultaneous resolution
+		 */
+		struct PendingHit
+		{
+			uint32_t slot;	  ///< Target's row in the dense state arrays
+			UnitId attacker;  ///< Unit that made the hit
+			int damage;		  ///< Damage dealt
+		};
+
 		Map _map;  ///< Spatial map for collision detection and movement
 		std::unordered_map<UnitId, std::unique_ptr<Entity>> _entities;	///< Entity collection with fast ID lookup
 		std::vector<UnitId> _entityOrder;								///< Turn order for deterministic simulation
+		std::vector<UnitState> _unitStates;								///< Dense state rows, parallel to _entityOrder
 		std::unique_ptr<sw::EventLog> _eventLog;						///< Event logging system
-		std::unordered_set<UnitId> _pendingRemoval;						///< Entities marked for deferred removal
+		std::vector<UnitId> _pendingRemoval;							///< Entities marked for deferred removal
+		std::vector<Entity*> _slotEntities;								///< Entity of each slot, parallel to _entityOrder
+		std::vector<uint32_t> _removedSlots;							///< Slots of a removal batch, reused across flushes
+		std::vector<SpatialIndex::Entry> _removedUnits;					///< Map entries of a removal batch, reused
+		uint64_t _stateHash{0};											///< Incremental world state hash
+		size_t _livingUnits{0};											///< Units for which isAlive() holds
+		TurnNumber _lastDamageTurn{0};									///< Last turn in which damage was applied
+		AIOptions _aiOptions;											///< Optional AI behaviours
+		DamageResolution _damageResolution{};							///< How hits are applied (sequential by default)
+		std::vector<PendingHit> _damageBuffer;							///< Hits awaiting simultaneous resolution
+		std::vector<int64_t> _damageTotals;								///< Per-slot damage sums, reused across turns
+		std::mt19937 _random{std::random_device{}()};					///< Random engine for AI decisions
 
 		/**
 		 * @brief Log map creation event
@@ -250,10 +513,59 @@ namespace sw::core
 		void logMapCreated(const Map::Dimensions& dimensions) const;
 
 		/**
-		 * @brief Schedule an entity for removal at end of turn
+		 * @brief Schedule a unit that just died for removal at end of turn
 		 * @param id Unit identifier to mark for removal
 		 */
 		void scheduleRemoval(UnitId id);
+
+		/**
+		 * @brief Lower a living target's HP, keep the state rows and hash in step and log the hit
+		 * @param attacker Entity dealing damage
+		 * @param target Entity receiving damage
+		 * @param config Damage configuration containing amount and turn
+		 * @return true if the hit killed the target
+		 */
+		auto inflictDamage(const Entity& attacker, const Entity& target, const DamageConfig& config) -> bool;
+
+		/**
+		 * @brief Apply damage to a unit's health component, keeping its state row and the state hash in step
+		 * @param target Entity receiving damage; must have a health component
+		 * @param amount Damage to apply
+		 * @return The target's health component
+		 */
+		auto lowerHealth(const Entity& target, int amount) -> IHealthStrategy&;
+
+		/**
+		 * @brief Compute an entity's current contribution to the state hash
+		 * @param entity Entity to hash
+		 * @return 64-bit contribution
+		 */
+		[[nodiscard]]
+		static auto stateContribution(const Entity& entity) -> uint64_t;
+
+		/**
+		 * @brief Validate, place and store a batch of entities without logging
+		 * @param entities Entities to add, in turn order
+		 * @return false (nothing changed) if an id or a placement is rejected
+		 */
+		auto insertEntities(std::vector<std::unique_ptr<Entity>>& entities) -> bool;
+
+		/**
+		 * @brief Remove a batch of entities and compact the dense state in one sweep
+		 *
+		 * Surviving entities keep their relative (creation) order. The map drops
+		 * the whole batch at once, and survivors are re-slotted through the
+		 * per-slot entity pointers. Unknown and repeated identifiers are ignored.
+		 *
+		 * @param ids Unit identifiers to remove
+		 */
+		void removeEntities(std::span<const UnitId> ids);
+
+		/**
+		 * @brief Append an entity to the turn order and dense state rows
+		 * @param entity Entity already stored in the entity collection
+		 */
+		void appendToOrder(Entity& entity);
 	};
 
 }
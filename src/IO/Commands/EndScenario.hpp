@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+namespace sw::io
+{
+	struct EndScenario
+	{
+		constexpr static const char* Name = "END";
+
+		template <typename Visitor>
+		void visit(Visitor&)
+		{}
+	};
+}
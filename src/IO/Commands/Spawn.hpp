@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace sw::io
+{
+	// Spawns a unit type from the unit catalog: the type's stats in declaration order, then an optional faction.
+	struct Spawn
+	{
+		constexpr static const char* Name = "SPAWN";
+
+		std::string unitType{};
+		uint32_t unitId{};
+		uint32_t x{};
+		uint32_t y{};
+		std::vector<uint32_t> values{};
+
+		template <typename Visitor>
+		void visit(Visitor& visitor)
+		{
+			visitor.visit("unitType", unitType);
+			visitor.visit("unitId", unitId);
+			visitor.visit("x", x);
+			visitor.visit("y", y);
+			visitor.visit("values", values);
+		}
+	};
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace sw::io
+{
+	// Fills a width x height rectangle row by row with copies of one unit, ids counting up from unitId.
+	// The values are the type's stats in SPAWN_<TYPE> or catalog order, then an optional faction.
+	struct SpawnBlock
+	{
+		constexpr static const char* Name = "SPAWN_BLOCK";
+
+		std::string unitType{};
+		uint32_t unitId{};
+		uint32_t x{};
+		uint32_t y{};
+		uint32_t width{};
+		uint32_t height{};
+		std::vector<uint32_t> values{};
+
+		template <typename Visitor>
+		void visit(Visitor& visitor)
+		{
+			visitor.visit("unitType", unitType);
+			visitor.visit("unitId", unitId);
+			visitor.visit("x", x);
+			visitor.visit("y", y);
+			visitor.visit("width", width);
+			visitor.visit("height", height);
+			visitor.visit("values", values);
+		}
+	};
+}
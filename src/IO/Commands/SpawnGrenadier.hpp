@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+
+namespace sw::io
+{
+	struct SpawnGrenadier
+	{
+		constexpr static const char* Name = "SPAWN_GRENADIER";
+
+		uint32_t unitId{};
+		uint32_t x{};
+		uint32_t y{};
+		uint32_t hp{};
+		uint32_t strength{};
+		uint32_t power{};
+		uint32_t range{};
+		uint32_t radius{};
+		std::optional<uint32_t> faction{};
+
+		template <typename Visitor>
+		void visit(Visitor& visitor)
+		{
+			visitor.visit("unitId", unitId);
+			visitor.visit("x", x);
+			visitor.visit("y", y);
+			visitor.visit("hp", hp);
+			visitor.visit("strength", strength);
+			visitor.visit("power", power);
+			visitor.visit("range", range);
+			visitor.visit("radius", radius);
+			visitor.visit("faction", faction);
+		}
+	};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace sw::io
+{
+	// Like SPAWN_BLOCK, but places columns x rows units `spacing` cells apart.
+	struct SpawnGrid
+	{
+		constexpr static const char* Name = "SPAWN_GRID";
+
+		std::string unitType{};
+		uint32_t unitId{};
+		uint32_t x{};
+		uint32_t y{};
+		uint32_t columns{};
+		uint32_t rows{};
+		uint32_t spacing{};
+		std::vector<uint32_t> values{};
+
+		template <typename Visitor>
+		void visit(Visitor& visitor)
+		{
+			visitor.visit("unitType", unitType);
+			visitor.visit("unitId", unitId);
+			visitor.visit("x", x);
+			visitor.visit("y", y);
+			visitor.visit("columns", columns);
+			visitor.visit("rows", rows);
+			visitor.visit("spacing", spacing);
+			visitor.visit("values", values);
+		}
+	};
+}
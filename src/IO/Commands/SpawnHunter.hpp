@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <iosfwd>
+#include <optional>
 
 namespace sw::io
 {
@@ -16,6 +17,7 @@ namespace sw::io
 		uint32_t agility{};
 		uint32_t strength{};
 		uint32_t range{};
+		std::optional<uint32_t> faction{};
 
 		template <typename Visitor>
 		void visit(Visitor& visitor)
@@ -27,6 +29,7 @@ namespace sw::io
 			visitor.visit("agility", agility);
 			visitor.visit("strength", strength);
 			visitor.visit("range", range);
+			visitor.visit("faction", faction);
 		}
 	};
 }
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <iosfwd>
+#include <optional>
 
 namespace sw::io
 {
@@ -14,6 +15,7 @@ namespace sw::io
 		uint32_t y{};
 		uint32_t hp{};
 		uint32_t strength{};
+		std::optional<uint32_t> faction{};
 
 		template <typename Visitor>
 		void visit(Visitor& visitor)
@@ -23,6 +25,7 @@ namespace sw::io
 			visitor.visit("y", y);
 			visitor.visit("hp", hp);
 			visitor.visit("strength", strength);
+			visitor.visit("faction", faction);
 		}
 	};
 }
@@ -12,7 +12,7 @@ namespace sw::io
 		uint32_t height{};
 
 		template <typename Visitor>
-		void visit(Visitor& visitor)
+		constexpr void visit(Visitor& visitor)
 		{
 			visitor.visit("width", width);
 			visitor.visit("height", height);
@@ -15,7 +15,7 @@ namespace sw::io
 		uint32_t targetY{};
 
 		template <typename Visitor>
-		void visit(Visitor& visitor)
+		constexpr void visit(Visitor& visitor)
 		{
 			visitor.visit("unitId", unitId);
 			visitor.visit("x", x);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 
 namespace sw::io
 {
@@ -11,13 +12,15 @@ namespace sw::io
 		uint32_t finalTurn{};
 		uint32_t survivors{};
 		uint32_t totalTurns{};
+		std::string reason{};
 
 		template <typename Visitor>
-		void visit(Visitor& visitor)
+		constexpr void visit(Visitor& visitor)
 		{
 			visitor.visit("finalTurn", finalTurn);
 			visitor.visit("survivors", survivors);
 			visitor.visit("totalTurns", totalTurns);
+			visitor.visit("reason", reason);
 		}
 	};
 }
@@ -12,7 +12,7 @@ namespace sw::io
 		uint32_t turn{};
 
 		template <typename Visitor>
-		void visit(Visitor& visitor)
+		constexpr void visit(Visitor& visitor)
 		{
 			visitor.visit("unitCount", unitCount);
 			visitor.visit("turn", turn);
@@ -15,7 +15,7 @@ namespace sw::io
 		uint32_t targetHp{};
 
 		template <typename Visitor>
-		void visit(Visitor& visitor)
+		constexpr void visit(Visitor& visitor)
 		{
 			visitor.visit("attackerUnitId", attackerUnitId);
 			visitor.visit("targetUnitId", targetUnitId);
@@ -14,7 +14,7 @@ namespace sw::io
 		uint32_t y{};
 
 		template <typename Visitor>
-		void visit(Visitor& visitor)
+		constexpr void visit(Visitor& visitor)
 		{
 			visitor.visit("unitId", unitId);
 			visitor.visit("x", x);
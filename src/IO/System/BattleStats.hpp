@@ -0,0 +1,58 @@
+#pragma once
+
+#include "IO/Events/SimulationEnded.hpp"
+#include "IO/Events/UnitAttacked.hpp"
+#include "IO/Events/UnitDied.hpp"
+#include "IO/Events/UnitMoved.hpp"
+#include "IO/Events/UnitSpawned.hpp"
+
+#include <cstdint>
+#include <ostream>
+
+namespace sw::io
+{
+	// EventBus subscriber that totals what happened in a battle.
+	class BattleStats
+	{
+	private:
+		uint64_t _spawned{0};
+		uint64_t _moves{0};
+		uint64_t _attacks{0};
+		uint64_t _damage{0};
+		uint64_t _deaths{0};
+		uint32_t _lastTurn{0};
+
+	public:
+		void operator()(uint32_t, const UnitSpawned&)
+		{
+			++_spawned;
+		}
+
+		void operator()(uint32_t, const UnitMoved&)
+		{
+			++_moves;
+		}
+
+		void operator()(uint32_t, const UnitAttacked& event)
+		{
+			++_attacks;
+			_damage += event.damage;
+		}
+
+		void operator()(uint32_t, const UnitDied&)
+		{
+			++_deaths;
+		}
+
+		void operator()(uint32_t, const SimulationEnded& event)
+		{
+			_lastTurn = event.finalTurn;
+		}
+
+		void report(std::ostream& stream) const
+		{
+			stream << "Battle stats: turns=" << _lastTurn << " spawned=" << _spawned << " moves=" << _moves
+				   << " attacks=" << _attacks << " damage=" << _damage << " deaths=" << _deaths << '\n';
+		}
+	};
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace sw::io
+{
+	// Fixed little-endian encoding so files written on one platform load on any other.
+	class BinaryWriter
+	{
+	private:
+		std::ostream& _stream;
+
+	public:
+		explicit BinaryWriter(std::ostream& stream) :
+				_stream(stream)
+		{}
+
+		template <class TValue>
+			requires std::is_integral_v<TValue>
+		void write(TValue value)
+		{
+			using Unsigned = std::make_unsigned_t<TValue>;
+			auto bits = static_cast<Unsigned>(value);
+			for (size_t i = 0; i < sizeof(TValue); ++i)
+			{
+				_stream.put(static_cast<char>(bits & 0xFFU));
+				bits = static_cast<Unsigned>(bits >> 8U);
+			}
+		}
+
+		void write(const std::string& value)
+		{
+			write(static_cast<uint32_t>(value.size()));
+			_stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+		}
+
+		void writeBytes(const char* data, size_t size)
+		{
+			_stream.write(data, static_cast<std::streamsize>(size));
+		}
+	};
+
+	class BinaryReader
+	{
+	private:
+		std::istream& _stream;
+
+	public:
+		explicit BinaryReader(std::istream& stream) :
+				_stream(stream)
+		{}
+
+		template <class TValue>
+			requires std::is_integral_v<TValue>
+		auto read() -> TValue
+		{
+			using Unsigned = std::make_unsigned_t<TValue>;
+			Unsigned bits = 0;
+			for (size_t i = 0; i < sizeof(TValue); ++i)
+			{
+				const int byte = _stream.get();
+				if (byte == std::istream::traits_type::eof())
+				{
+					throw std::runtime_error("Unexpected end of binary stream");
+				}
+				bits |= static_cast<Unsigned>(static_cast<Unsigned>(byte) << (8U * i));
+			}
+			return static_cast<TValue>(bits);
+		}
+
+		auto readString() -> std::string
+		{
+			const auto size = read<uint32_t>();
+			std::string value(size, '\0');
+			readBytes(value.data(), size);
+			return value;
+		}
+
+		void readBytes(char* data, size_t size)
+		{
+			if (!_stream.read(data, static_cast<std::streamsize>(size)))
+			{
+				throw std::runtime_error("Unexpected end of binary stream");
+			}
+		}
+	};
+
+	// Little-endian integer at an offset of an in-memory image; the caller checks the bounds.
+	template <class TValue>
+		requires std::is_integral_v<TValue>
+	auto loadLittleEndian(std::span<const char> bytes, size_t offset) -> TValue
+	{
+		using Unsigned = std::make_unsigned_t<TValue>;
+		Unsigned bits = 0;
+		for (size_t i = 0; i < sizeof(TValue); ++i)
+		{
+			bits |= static_cast<Unsigned>(static_cast<Unsigned>(static_cast<uint8_t>(bytes[offset + i])) << (8U * i));
+		}
+		return static_cast<TValue>(bits);
+	}
+}
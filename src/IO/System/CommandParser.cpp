@@ -7,27 +7,45 @@ namespace sw::io
 		std::string line;
 		while (std::getline(stream, line))
 		{
-			if (line.rfind("//", 0) == 0 || line.empty())
-			{
-				continue;
-			}
+			execute(line);
+		}
+	}
 
-			std::istringstream commandStream(line);
-			std::string commandName;
-			commandStream >> commandName;
+	void CommandParser::execute(const std::string& line)
+	{
+		if (line.rfind("//", 0) == 0 || line.empty())
+		{
+			return;
+		}
 
-			if (commandName.empty())
-			{
-				continue;
-			}
+		std::istringstream commandStream(line);
+		std::string commandName;
+		commandStream >> commandName;
+
+		if (commandName.empty())
+		{
+			return;
+		}
 
-			auto command = _commands.find(commandName);
-			if (command == _commands.end())
+		if (commandName == "AT" && _deferred)
+		{
+			uint32_t turn = 0;
+			if (!(commandStream >> turn))
 			{
-				throw std::runtime_error("Unknown command: " + commandName);
+				throw std::runtime_error("AT expects a turn number: " + line);
 			}
+			std::string commandLine;
+			std::getline(commandStream >> std::ws, commandLine);
+			_deferred(turn, std::move(commandLine));
+			return;
+		}
 
-			command->second(commandStream);
+		auto command = _commands.find(commandName);
+		if (command == _commands.end())
+		{
+			throw std::runtime_error("Unknown command: " + commandName);
 		}
+
+		command->second(commandStream);
 	}
 }
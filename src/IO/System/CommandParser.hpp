@@ -2,6 +2,7 @@
 
 #include "details/CommandParserVisitor.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <sstream>
 #include <string>
@@ -10,8 +11,13 @@ namespace sw::io
 {
 	class CommandParser
 	{
+	public:
+		// Receives "AT <turn> <command>" lines: the turn stamp and the command text to run at that turn.
+		using DeferredHandler = std::function<void(uint32_t turn, std::string commandLine)>;
+
 	private:
 		std::unordered_map<std::string, std::function<void(std::istream&)>> _commands;
+		DeferredHandler _deferred;
 
 	public:
 		template <class TCommandData>
@@ -35,6 +41,16 @@ namespace sw::io
 			return *this;
 		}
 
+		// Enables the "AT <turn> ..." prefix; without a handler such lines are rejected as unknown commands.
+		CommandParser& onDeferred(DeferredHandler handler)
+		{
+			_deferred = std::move(handler);
+			return *this;
+		}
+
 		void parse(std::istream& stream);
+
+		// Parses and runs a single command line; comments and blank lines are ignored.
+		void execute(const std::string& line);
 	};
 }
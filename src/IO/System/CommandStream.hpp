@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CommandParser.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <string>
+
+namespace sw::io
+{
+	// Incrementally feeds a command stream to a parser at turn boundaries. Plain commands run as soon as
+	// they are read; "AT <turn> ..." commands go to the parser's deferred handler. Reading stops at the
+	// first command stamped after the requested turn, so only one command of lookahead is ever buffered.
+	class CommandStreamReader
+	{
+	private:
+		std::istream& _stream;
+		CommandParser& _parser;
+
+	public:
+		CommandStreamReader(std::istream& stream, CommandParser& parser) :
+				_stream(stream),
+				_parser(parser)
+		{}
+
+		// Returns false once the stream is exhausted.
+		auto readThrough(uint32_t turn) -> bool
+		{
+			std::string line;
+			while (std::getline(_stream, line))
+			{
+				_parser.execute(line);
+
+				std::istringstream probe(line);
+				std::string commandName;
+				uint32_t stamp = 0;
+				if (probe >> commandName && commandName == "AT" && probe >> stamp && stamp > turn)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+}
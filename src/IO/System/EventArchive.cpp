@@ -0,0 +1,174 @@
+#include "EventArchive.hpp"
+
+#include "BinaryStream.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace sw::io
+{
+	namespace
+	{
+		constexpr uint32_t ArchiveMagic = 0x41455753;  // "SWEA"
+		constexpr uint32_t ArchiveVersion = 1;
+		constexpr size_t HeaderSize = 8;
+		constexpr size_t TrailerSize = 12;
+		constexpr size_t BlockHeaderSize = 12 + (4 * details::ArchiveColumnCount);
+		constexpr size_t IndexEntrySize = 20;
+
+		[[noreturn]]
+		void corrupt(const std::string& reason)
+		{
+			throw std::runtime_error("Corrupt event archive: " + reason);
+		}
+	}
+
+	EventArchiveWriter::EventArchiveWriter(const std::filesystem::path& path, const uint32_t turnsPerBlock) :
+			_file(path, std::ios::binary | std::ios::trunc),
+			_path(path),
+			_turnsPerBlock(std::max(turnsPerBlock, 1U))
+	{
+		if (!_file)
+		{
+			throw std::runtime_error("Failed to open event archive for writing: " + path.string());
+		}
+		BinaryWriter writer(_file);
+		writer.write(ArchiveMagic);
+		writer.write(ArchiveVersion);
+	}
+
+	EventArchiveWriter::~EventArchiveWriter()
+	{
+		try
+		{
+			close();
+		}
+		catch (const std::exception&)
+		{
+			// Destructors must not throw; call close() to see write errors
+		}
+	}
+
+	void EventArchiveWriter::flushBlock()
+	{
+		_index.push_back(
+			{.firstTurn = _block.firstTurn,
+			 .lastTurn = _block.lastTurn,
+			 .offset = static_cast<uint64_t>(_file.tellp()),
+			 .eventCount = _block.eventCount});
+
+		BinaryWriter writer(_file);
+		writer.write(_block.eventCount);
+		writer.write(_block.firstTurn);
+		writer.write(_block.lastTurn);
+		for (const auto& column : _block.columns)
+		{
+			writer.write(static_cast<uint32_t>(column.size()));
+		}
+		for (const auto& column : _block.columns)
+		{
+			writer.writeBytes(column.data(), column.size());
+		}
+		_block.clear();
+	}
+
+	void EventArchiveWriter::close()
+	{
+		if (_closed)
+		{
+			return;
+		}
+		_closed = true;
+
+		if (_block.eventCount > 0)
+		{
+			flushBlock();
+		}
+
+		const auto footerOffset = static_cast<uint64_t>(_file.tellp());
+		BinaryWriter writer(_file);
+		writer.write(static_cast<uint32_t>(_index.size()));
+		for (const auto& block : _index)
+		{
+			writer.write(block.firstTurn);
+			writer.write(block.lastTurn);
+			writer.write(block.offset);
+			writer.write(block.eventCount);
+		}
+		writer.write(footerOffset);
+		writer.write(ArchiveMagic);
+
+		_file.close();
+		if (!_file)
+		{
+			throw std::runtime_error("Failed to write event archive: " + _path.string());
+		}
+	}
+
+	EventArchiveReader::EventArchiveReader(const std::filesystem::path& path) :
+			_file(path)
+	{
+		const auto bytes = _file.bytes();
+		if (bytes.size() < HeaderSize + TrailerSize || loadLittleEndian<uint32_t>(bytes, 0) != ArchiveMagic
+			|| loadLittleEndian<uint32_t>(bytes, bytes.size() - 4) != ArchiveMagic)
+		{
+			throw std::runtime_error("Not an event archive: " + path.string());
+		}
+		if (const auto version = loadLittleEndian<uint32_t>(bytes, 4); version != ArchiveVersion)
+		{
+			throw std::runtime_error("Unsupported event archive version " + std::to_string(version));
+		}
+
+		const auto footerOffset = loadLittleEndian<uint64_t>(bytes, bytes.size() - TrailerSize);
+		const size_t footerEnd = bytes.size() - TrailerSize;
+		if (footerOffset < HeaderSize || footerOffset > footerEnd - 4)
+		{
+			corrupt("footer offset out of range");
+		}
+
+		const auto blockCount = loadLittleEndian<uint32_t>(bytes, footerOffset);
+		if (blockCount > (footerEnd - footerOffset - 4) / IndexEntrySize)
+		{
+			corrupt("footer index truncated");
+		}
+
+		_blocks.reserve(blockCount);
+		for (size_t entry = footerOffset + 4; _blocks.size() < blockCount; entry += IndexEntrySize)
+		{
+			const ArchiveBlockInfo block{
+				.firstTurn = loadLittleEndian<uint32_t>(bytes, entry),
+				.lastTurn = loadLittleEndian<uint32_t>(bytes, entry + 4),
+				.offset = loadLittleEndian<uint64_t>(bytes, entry + 8),
+				.eventCount = loadLittleEndian<uint32_t>(bytes, entry + 16)};
+			if (block.offset < HeaderSize || block.offset + BlockHeaderSize > footerOffset)
+			{
+				corrupt("block offset out of range");
+			}
+			_blocks.push_back(block);
+		}
+	}
+
+	auto EventArchiveReader::columns(const ArchiveBlockInfo& block) const
+		-> std::array<std::span<const char>, details::ArchiveColumnCount>
+	{
+		const auto bytes = _file.bytes();
+		if (loadLittleEndian<uint32_t>(bytes, block.offset) != block.eventCount)
+		{
+			corrupt("block header does not match the index");
+		}
+
+		std::array<std::span<const char>, details::ArchiveColumnCount> result;
+		size_t offset = block.offset + BlockHeaderSize;
+		for (size_t column = 0; column < result.size(); ++column)
+		{
+			const auto size = loadLittleEndian<uint32_t>(bytes, block.offset + 12 + (4 * column));
+			if (size > bytes.size() - offset)
+			{
+				corrupt("column runs past the end of the file");
+			}
+			result[column] = bytes.subspan(offset, size);
+			offset += size;
+		}
+		return result;
+	}
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "EventLog.hpp"
+#include "MappedFile.hpp"
+#include "details/ArchiveColumns.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace sw::io
+{
+	// Location and turn range of one archive block, as listed in the archive's footer index.
+	struct ArchiveBlockInfo
+	{
+		uint32_t firstTurn{};
+		uint32_t lastTurn{};
+		uint64_t offset{};
+		uint32_t eventCount{};
+	};
+
+	// Event sink writing a compact columnar archive: an EventBus subscriber for every event type.
+	//
+	// Events are grouped into blocks covering up to turnsPerBlock turns (a block only ends between turns).
+	// Each block stores its events column by column - turn, type, unit ids, x, y, other numbers, text -
+	// as varints, with turns, ids and coordinates delta-coded. A footer maps each block's turn range to its
+	// offset, so readers decode only the blocks a turn range touches.
+	class EventArchiveWriter
+	{
+	private:
+		static constexpr uint32_t MaxBlockEvents = 1U << 16U;
+
+		std::ofstream _file;
+		std::filesystem::path _path;
+		uint32_t _turnsPerBlock;
+		details::ArchiveBlock _block;
+		std::vector<ArchiveBlockInfo> _index;
+		bool _closed{false};
+
+		void flushBlock();
+
+	public:
+		explicit EventArchiveWriter(const std::filesystem::path& path, uint32_t turnsPerBlock = 1024);
+		~EventArchiveWriter();
+		EventArchiveWriter(const EventArchiveWriter&) = delete;
+		auto operator=(const EventArchiveWriter&) -> EventArchiveWriter& = delete;
+
+		template <class TEvent>
+		void operator()(uint32_t turn, const TEvent& event)
+		{
+			const bool newTurn = turn != _block.lastTurn;
+			if (_block.eventCount > 0 && newTurn
+				&& (turn < _block.firstTurn || turn - _block.firstTurn >= _turnsPerBlock
+					|| _block.eventCount >= MaxBlockEvents))
+			{
+				flushBlock();
+			}
+
+			_block.begin(turn, EventIndex<TEvent>);
+			TEvent fields = event;
+			details::ColumnEncoder encoder(_block);
+			fields.visit(encoder);
+		}
+
+		// Writes the last block and the footer index. Also done on destruction, minus the error report.
+		void close();
+	};
+
+	// Random-access reader over an event archive. The file is memory-mapped and only the blocks
+	// overlapping a requested turn range are decoded.
+	class EventArchiveReader
+	{
+	private:
+		MappedFile _file;
+		std::vector<ArchiveBlockInfo> _blocks;
+
+		[[nodiscard]]
+		auto columns(const ArchiveBlockInfo& block) const
+			-> std::array<std::span<const char>, details::ArchiveColumnCount>;
+
+		template <class TEvent, class TVisitor>
+		static void decodeAs(details::ColumnDecoder& decoder, uint32_t turn, bool wanted, TVisitor& visitor)
+		{
+			TEvent event;
+			event.visit(decoder);
+			if (wanted)
+			{
+				visitor(turn, event);
+			}
+		}
+
+		template <class TVisitor, class... TEvents>
+		static void decodeEvent(
+			details::ColumnDecoder& decoder, uint32_t turn, bool wanted, TVisitor& visitor, std::tuple<TEvents...>*)
+		{
+			const uint8_t type = decoder.type();
+			uint8_t index = 0;
+			const bool known
+				= ((index++ == type && (decodeAs<TEvents>(decoder, turn, wanted, visitor), true)) || ...);
+			if (!known)
+			{
+				throw std::runtime_error("Event archive contains unknown event type " + std::to_string(type));
+			}
+		}
+
+	public:
+		explicit EventArchiveReader(const std::filesystem::path& path);
+
+		[[nodiscard]]
+		auto blocks() const noexcept -> std::span<const ArchiveBlockInfo>
+		{
+			return _blocks;
+		}
+
+		// Calls visitor(turn, event) with a mutable typed event for every event logged in [fromTurn, toTurn].
+		template <class TVisitor>
+		void forEach(uint32_t fromTurn, uint32_t toTurn, TVisitor&& visitor) const
+		{
+			// The index is tiny next to the blocks, so it is checked entry by entry
+			for (const ArchiveBlockInfo& block : _blocks)
+			{
+				if (block.lastTurn < fromTurn || block.firstTurn > toTurn)
+				{
+					continue;
+				}
+
+				details::ColumnDecoder decoder(columns(block));
+				for (uint32_t i = 0; i < block.eventCount; ++i)
+				{
+					const uint32_t turn = decoder.turn();
+					decodeEvent(
+						decoder,
+						turn,
+						turn >= fromTurn && turn <= toTurn,
+						visitor,
+						static_cast<EventTypes*>(nullptr));
+				}
+			}
+		}
+	};
+}
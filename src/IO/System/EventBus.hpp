@@ -0,0 +1,96 @@
+#pragma once
+
+#include "EventLog.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace sw
+{
+	// A subscriber handles an event type when it can be called as subscriber(turn, event).
+	template <class TSubscriber, class TEvent>
+	concept EventHandler = std::invocable<TSubscriber&, uint32_t, const TEvent&>;
+
+	// Event types must come from EventTypes, so a typo cannot silently create a new channel.
+	template <class TEvent, class TEvents = EventTypes>
+	inline constexpr bool IsEventType = false;
+
+	template <class TEvent, class... TEvents>
+	inline constexpr bool IsEventType<TEvent, std::tuple<TEvents...>> = (std::is_same_v<TEvent, TEvents> || ...);
+
+	// Typed event bus whose subscriber list is fixed at compile time.
+	// Within the bus, log() calls every subscriber that handles the event directly, with no virtual call
+	// or allocation, and compiles to nothing for event types no subscriber handles.
+	// Simulation events reach the bus through attach(): one EventLog callback per handled type, so each
+	// event costs one indirect call into the bus, however many subscribers it has.
+	// Subscribers are referenced, not copied, and must outlive the bus.
+	template <class... TSubscribers>
+	class EventBus
+	{
+	private:
+		std::tuple<TSubscribers&...> _subscribers;
+
+		template <class TSubscriber, class TEvent>
+		static void notify(TSubscriber& subscriber, uint32_t turn, const TEvent& event)
+		{
+			if constexpr (EventHandler<TSubscriber, TEvent>)
+			{
+				subscriber(turn, event);
+			}
+		}
+
+		template <class... TEvents>
+		void attachAll(EventLog& log, std::tuple<TEvents...>*)
+		{
+			(attachOne<TEvents>(log), ...);
+		}
+
+		template <class TEvent>
+		void attachOne(EventLog& log)
+		{
+			if constexpr (Handles<TEvent>)
+			{
+				log.subscribe(EventCallback<TEvent>(*this));
+			}
+		}
+
+	public:
+		template <class TEvent>
+		static constexpr bool Handles = (EventHandler<TSubscribers, TEvent> || ...);
+
+		explicit EventBus(TSubscribers&... subscribers) :
+				_subscribers(subscribers...)
+		{}
+
+		// attach() hands out pointers to the bus, so it stays put.
+		EventBus(const EventBus&) = delete;
+		auto operator=(const EventBus&) -> EventBus& = delete;
+
+		template <class TEvent>
+		void log(uint32_t turn, const TEvent& event)
+		{
+			static_assert(IsEventType<TEvent>, "not an event type from IO/Events");
+			if constexpr (Handles<TEvent>)
+			{
+				std::apply([&](auto&... subscribers) { (notify(subscribers, turn, event), ...); }, _subscribers);
+			}
+		}
+
+		template <class TEvent>
+		void operator()(uint32_t turn, const TEvent& event)
+		{
+			log(turn, event);
+		}
+
+		// Receive a simulation's events: one EventLog subscription per event type some subscriber handles.
+		void attach(EventLog& log)
+		{
+			attachAll(log, static_cast<EventTypes*>(nullptr));
+		}
+	};
+
+	template <class... TSubscribers>
+	EventBus(TSubscribers&...) -> EventBus<TSubscribers...>;
+}
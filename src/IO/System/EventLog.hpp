@@ -1,23 +1,239 @@
 #pragma once
 
-#include "details/PrintFieldVisitor.hpp"
+#include "EventTypes.hpp"
+#include "ParallelTextSink.hpp"
+#include "details/EventSerializer.hpp"
 
+#include <cstdint>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace sw
 {
+	// Non-owning typed callback: a context pointer plus a thunk, so dispatch never allocates.
+	// The referenced callable must outlive the subscription.
+	template <class TEvent>
+	class EventCallback
+	{
+	private:
+		void* _context;
+		void (*_invoke)(void*, uint32_t, const TEvent&);
+
+	public:
+		template <class TCallable>
+		explicit EventCallback(TCallable& callable) :
+				_context(&callable),
+				_invoke(
+					[](void* context, uint32_t turn, const TEvent& event)
+					{ (*static_cast<TCallable*>(context))(turn, event); })
+		{}
+
+		void operator()(uint32_t turn, const TEvent& event) const
+		{
+			_invoke(_context, turn, event);
+		}
+	};
+
 	class EventLog
 	{
+	private:
+		template <class TEvents>
+		struct CallbackTable;
+
+		template <class... TEvents>
+		struct CallbackTable<std::tuple<TEvents...>>
+		{
+			using Type = std::tuple<std::vector<EventCallback<TEvents>>...>;
+		};
+
+		std::ostream* _output = &std::cout;
+		io::ParallelTextSink* _textSink = nullptr;
+		CallbackTable<EventTypes>::Type _callbacks;
+		uint32_t _printMask = AllEvents;
+		uint32_t _wanted = AllEvents;  // Printed or subscribed types: the ones worth building
+		std::optional<uint32_t> _unitFilter;
+		std::string _line;	// Reused text of the event being printed
+
+		// Checks whether any unit id field of an event names the filtered unit
+		struct UnitIdMatcher
+		{
+			uint32_t unitId;
+			bool hasUnitField = false;
+			bool matches = false;
+
+			template <typename T>
+			void visit(const char* name, const T& value)
+			{
+				if constexpr (std::is_same_v<T, uint32_t>)
+				{
+					if (const std::string_view field = name; field == "unitId" || field.ends_with("UnitId"))
+					{
+						hasUnitField = true;
+						matches = matches || value == unitId;
+					}
+				}
+			}
+		};
+
+		template <class TEvent>
+		auto callbacks() -> std::vector<EventCallback<TEvent>>&
+		{
+			return std::get<std::vector<EventCallback<TEvent>>>(_callbacks);
+		}
+
+		void updateWanted()
+		{
+			_wanted = _output != nullptr || _textSink != nullptr ? _printMask : 0U;
+			std::apply(
+				[this](const auto&... lists) { ((_wanted |= lists.empty() ? 0U : bitOf(lists)), ...); }, _callbacks);
+		}
+
+		template <class TEvent>
+		static auto bitOf(const std::vector<EventCallback<TEvent>>&) -> uint32_t
+		{
+			return EventBit<TEvent>;
+		}
+
+		template <class... TEvents>
+		static auto eventBit(std::string_view name, std::tuple<TEvents...>*) -> uint32_t
+		{
+			uint32_t bit = 0;
+			((bit = name == TEvents::Name ? EventBit<TEvents> : bit), ...);
+			return bit;
+		}
+
 	public:
+		EventLog() = default;
+
+		explicit EventLog(std::ostream* output) :
+				_output(output)
+		{}
+
+		// nullptr disables text output; subscribers are still notified.
+		void setOutput(std::ostream* output)
+		{
+			_output = output;
+			updateWanted();
+		}
+
+		// Printed events go to the sink, which formats them in batches, instead of the output stream.
+		// The sink must outlive the log or be reset to nullptr.
+		void setTextSink(io::ParallelTextSink* sink)
+		{
+			_textSink = sink;
+			updateWanted();
+		}
+
+		// Writes out events still buffered by the text sink.
+		void flush()
+		{
+			if (_textSink != nullptr)
+			{
+				_textSink->flush();
+			}
+		}
+
+		// Only event types in the mask (EventBit values) are printed; subscribers still get every type.
+		void setPrintMask(uint32_t mask)
+		{
+			_printMask = mask;
+			updateWanted();
+		}
+
+		// Only print events involving this unit; events without unit ids are always printed.
+		void setUnitFilter(std::optional<uint32_t> unitId)
+		{
+			_unitFilter = unitId;
+		}
+
+		// Parses a comma-separated list of event names, e.g. "UNIT_DIED,MARCH_ENDED".
+		static auto parseEventMask(std::string_view names) -> uint32_t
+		{
+			uint32_t mask = 0;
+			while (!names.empty())
+			{
+				const auto comma = names.find(',');
+				const auto name = names.substr(0, comma);
+				const uint32_t bit = eventBit(name, static_cast<EventTypes*>(nullptr));
+				if (bit == 0)
+				{
+					throw std::invalid_argument("Unknown event type: " + std::string(name));
+				}
+				mask |= bit;
+				names = comma == std::string_view::npos ? std::string_view{} : names.substr(comma + 1);
+			}
+			return mask;
+		}
+
+		// Whether anyone consumes TEvent; callers skip building events nobody wants.
+		template <class TEvent>
+		[[nodiscard]]
+		auto wants() const noexcept -> bool
+		{
+			return (_wanted & EventBit<TEvent>) != 0;
+		}
+
+		template <class TEvent>
+		void subscribe(EventCallback<TEvent> callback)
+		{
+			callbacks<TEvent>().push_back(callback);
+			updateWanted();
+		}
+
+		void clearSubscriptions()
+		{
+			std::apply([](auto&... lists) { (lists.clear(), ...); }, _callbacks);
+			updateWanted();
+		}
+
 		template <class TEvent>
 		void log(uint32_t turn, TEvent&& event)
 		{
 			using EventType = std::decay_t<TEvent>;
-			std::cout << turn << " " << EventType::Name << " ";
-			PrintFieldVisitor visitor(std::cout);
-			event.visit(visitor);
-			std::cout << std::endl;
+			if (!wants<EventType>())
+			{
+				return;
+			}
+
+			const bool printing = _output != nullptr || _textSink != nullptr;
+			if (printing && (_printMask & EventBit<EventType>) != 0 && printsUnits(event))
+			{
+				if (_textSink != nullptr)
+				{
+					_textSink->push(turn, event);
+				}
+				else
+				{
+					_line.clear();
+					io::details::EventSerializer<EventType>::append(_line, turn, event);
+					_output->write(_line.data(), static_cast<std::streamsize>(_line.size()));
+					_output->flush();
+				}
+			}
+
+			for (const auto& callback : callbacks<EventType>())
+			{
+				callback(turn, event);
+			}
+		}
+
+	private:
+		template <class TEvent>
+		auto printsUnits(TEvent& event) const -> bool
+		{
+			if (!_unitFilter)
+			{
+				return true;
+			}
+			UnitIdMatcher matcher{.unitId = *_unitFilter};
+			event.visit(matcher);
+			return !matcher.hasUnitField || matcher.matches;
 		}
 	};
 }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IO/Events/MapCreated.hpp"
+#include "IO/Events/MarchEnded.hpp"
+#include "IO/Events/MarchStarted.hpp"
+#include "IO/Events/SimulationEnded.hpp"
+#include "IO/Events/SimulationStarted.hpp"
+#include "IO/Events/UnitAttacked.hpp"
+#include "IO/Events/UnitDied.hpp"
+#include "IO/Events/UnitMoved.hpp"
+#include "IO/Events/UnitSpawned.hpp"
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace sw
+{
+	// Every event type the simulation emits
+	using EventTypes = std::tuple<
+		io::MapCreated,
+		io::MarchEnded,
+		io::MarchStarted,
+		io::SimulationEnded,
+		io::SimulationStarted,
+		io::UnitAttacked,
+		io::UnitDied,
+		io::UnitMoved,
+		io::UnitSpawned>;
+
+	// Position of an event type in EventTypes, used as its bit in event masks
+	template <class TEvent, class... TEvents>
+	constexpr auto eventIndex(std::tuple<TEvents...>*) -> uint32_t
+	{
+		constexpr std::array matches{std::is_same_v<TEvent, TEvents>...};
+		uint32_t index = 0;
+		while (index < matches.size() && !matches[index])
+		{
+			++index;
+		}
+		return index;
+	}
+
+	template <class TEvent>
+	inline constexpr uint32_t EventIndex = eventIndex<TEvent>(static_cast<EventTypes*>(nullptr));
+
+	template <class TEvent>
+	inline constexpr uint32_t EventBit = 1U << EventIndex<TEvent>;
+
+	inline constexpr uint32_t AllEvents = (1U << std::tuple_size_v<EventTypes>) - 1;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <iomanip>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace sw::io
+{
+	// Text trace of per-turn world state hashes: one "<turn> <hash-hex>" line per turn.
+	class HashTraceWriter
+	{
+	private:
+		std::ostream& _stream;
+
+	public:
+		explicit HashTraceWriter(std::ostream& stream) :
+				_stream(stream)
+		{}
+
+		void record(uint32_t turn, uint64_t hash)
+		{
+			_stream << turn << ' ' << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << '\n';
+		}
+	};
+
+	// Compares a run against a reference trace and remembers the first turn that differs.
+	class HashTraceVerifier
+	{
+	public:
+		struct Entry
+		{
+			uint32_t turn{};
+			uint64_t hash{};
+		};
+
+	private:
+		std::vector<Entry> _reference;
+		size_t _next{0};
+		std::optional<Entry> _expected;
+		std::optional<Entry> _actual;
+
+	public:
+		explicit HashTraceVerifier(std::istream& reference)
+		{
+			Entry entry;
+			while (reference >> entry.turn >> std::hex >> entry.hash >> std::dec)
+			{
+				_reference.push_back(entry);
+			}
+		}
+
+		void record(uint32_t turn, uint64_t hash)
+		{
+			if (diverged())
+			{
+				return;
+			}
+
+			const Entry actual{.turn = turn, .hash = hash};
+			if (_next >= _reference.size())
+			{
+				_actual = actual;
+				return;
+			}
+
+			const Entry& expected = _reference[_next++];
+			if (expected.turn != turn || expected.hash != hash)
+			{
+				_expected = expected;
+				_actual = actual;
+			}
+		}
+
+		// Call once the run is over: a run that stops early diverges at the first missing turn.
+		void finish()
+		{
+			if (!diverged() && _next < _reference.size())
+			{
+				_expected = _reference[_next];
+			}
+		}
+
+		[[nodiscard]]
+		auto diverged() const -> bool
+		{
+			return _expected.has_value() || _actual.has_value();
+		}
+
+		[[nodiscard]]
+		auto expected() const -> const std::optional<Entry>&
+		{
+			return _expected;
+		}
+
+		[[nodiscard]]
+		auto actual() const -> const std::optional<Entry>&
+		{
+			return _actual;
+		}
+
+		[[nodiscard]]
+		auto checkedTurns() const -> size_t
+		{
+			return _next;
+		}
+	};
+}
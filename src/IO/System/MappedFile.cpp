@@ -0,0 +1,75 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef SW_HAS_MMAP
+	#include <cerrno>
+	#include <cstring>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#else
+	#include <fstream>
+	#include <iterator>
+#endif
+
+namespace sw::io
+{
+#ifdef SW_HAS_MMAP
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			throw std::runtime_error("Failed to open " + path.string() + ": " + std::strerror(errno));
+		}
+
+		struct stat info{};
+		if (::fstat(fd, &info) != 0)
+		{
+			const std::string reason = std::strerror(errno);
+			::close(fd);
+			throw std::runtime_error("Failed to stat " + path.string() + ": " + reason);
+		}
+
+		_size = static_cast<size_t>(info.st_size);
+		if (_size > 0)
+		{
+			void* mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapping == MAP_FAILED)
+			{
+				const std::string reason = std::strerror(errno);
+				::close(fd);
+				throw std::runtime_error("Failed to map " + path.string() + ": " + reason);
+			}
+			_data = static_cast<const char*>(mapping);
+		}
+		// The mapping stays valid after the descriptor is closed
+		::close(fd);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (_data != nullptr)
+		{
+			::munmap(const_cast<char*>(_data), _size);
+		}
+	}
+#else
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			throw std::runtime_error("Failed to open " + path.string());
+		}
+		_fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		_data = _fallback.data();
+		_size = _fallback.size();
+	}
+
+	MappedFile::~MappedFile() = default;
+#endif
+}
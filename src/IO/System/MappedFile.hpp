@@ -0,0 +1,34 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define SW_HAS_MMAP 1
+#endif
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace sw::io
+{
+	// Read-only view of a whole file; memory-mapped where supported, otherwise read into memory.
+	class MappedFile
+	{
+	private:
+		const char* _data{nullptr};
+		size_t _size{0};
+		std::vector<char> _fallback;
+
+	public:
+		explicit MappedFile(const std::filesystem::path& path);
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+		[[nodiscard]]
+		auto bytes() const noexcept -> std::span<const char>
+		{
+			return {_data, _size};
+		}
+	};
+}
@@ -0,0 +1,74 @@
+#include "ParallelTextSink.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace sw::io
+{
+	namespace
+	{
+		// Smallest chunk worth handing to another thread
+		constexpr size_t MinChunkRecords = 1024;
+		// Chunks per thread, so a slow chunk does not leave the others idle
+		constexpr size_t ChunksPerThread = 4;
+	}
+
+	ParallelTextSink::ParallelTextSink(std::ostream& output, ThreadPool& pool, const size_t batchSize) :
+			_output(output),
+			_pool(pool),
+			_batchSize(std::max<size_t>(batchSize, 1))
+	{
+		_records.reserve(_batchSize);
+	}
+
+	ParallelTextSink::~ParallelTextSink()
+	{
+		try
+		{
+			flush();
+		}
+		catch (const std::exception&)
+		{
+			// Destructors must not throw; call flush() to see errors
+		}
+	}
+
+	void ParallelTextSink::formatChunk(const size_t chunk, const size_t chunkCount)
+	{
+		const size_t begin = _records.size() * chunk / chunkCount;
+		const size_t end = _records.size() * (chunk + 1) / chunkCount;
+		std::string& text = _chunks[chunk];
+		text.clear();
+		for (size_t i = begin; i < end; ++i)
+		{
+			Record& record = _records[i];
+			std::visit(
+				[&text, turn = record.turn]<class TEvent>(TEvent& event)
+				{ details::EventSerializer<TEvent>::append(text, turn, event); },
+				record.event);
+		}
+	}
+
+	void ParallelTextSink::flush()
+	{
+		if (_records.empty())
+		{
+			return;
+		}
+
+		const size_t chunkCount = std::clamp<size_t>(
+			_records.size() / MinChunkRecords, 1, _pool.size() * ChunksPerThread);
+		if (_chunks.size() < chunkCount)
+		{
+			_chunks.resize(chunkCount);
+		}
+		_pool.parallelFor(chunkCount, [this, chunkCount](size_t chunk) { formatChunk(chunk, chunkCount); });
+
+		for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			_output.write(_chunks[chunk].data(), static_cast<std::streamsize>(_chunks[chunk].size()));
+		}
+		_output.flush();
+		_records.clear();
+	}
+}
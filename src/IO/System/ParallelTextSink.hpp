@@ -0,0 +1,68 @@
+#pragma once
+
+#include "EventTypes.hpp"
+#include "ThreadPool.hpp"
+#include "details/EventSerializer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace sw::io
+{
+	// Event log text output that formats whole batches of events in parallel.
+	//
+	// Events are kept as typed records until a batch of at least batchSize records is complete at a turn
+	// boundary. The batch is then split into chunks, the chunks are formatted concurrently on the pool
+	// into separate buffers, and the buffers are written in order - the text is identical to the
+	// line-by-line log, only written in large pieces.
+	class ParallelTextSink
+	{
+	private:
+		template <class TEvents>
+		struct RecordVariant;
+
+		template <class... TEvents>
+		struct RecordVariant<std::tuple<TEvents...>>
+		{
+			using Type = std::variant<TEvents...>;
+		};
+
+		struct Record
+		{
+			uint32_t turn{};
+			RecordVariant<EventTypes>::Type event;
+		};
+
+		std::ostream& _output;
+		ThreadPool& _pool;
+		size_t _batchSize;
+		std::vector<Record> _records;
+		std::vector<std::string> _chunks;
+
+		void formatChunk(size_t chunk, size_t chunkCount);
+
+	public:
+		ParallelTextSink(std::ostream& output, ThreadPool& pool, size_t batchSize = 1U << 14U);
+		~ParallelTextSink();
+		ParallelTextSink(const ParallelTextSink&) = delete;
+		auto operator=(const ParallelTextSink&) -> ParallelTextSink& = delete;
+
+		template <class TEvent>
+		void push(uint32_t turn, const TEvent& event)
+		{
+			if (_records.size() >= _batchSize && turn != _records.back().turn)
+			{
+				flush();
+			}
+			_records.push_back({.turn = turn, .event = event});
+		}
+
+		// Formats and writes every buffered event, then flushes the stream.
+		void flush();
+	};
+}
@@ -0,0 +1,116 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sw::io
+{
+	ThreadPool::ThreadPool(size_t threads)
+	{
+		if (threads == 0)
+		{
+			threads = std::max(std::thread::hardware_concurrency(), 1U);
+		}
+		_workers.reserve(threads - 1);
+		for (size_t i = 1; i < threads; ++i)
+		{
+			_workers.emplace_back([this] { workerLoop(); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(_mutex);
+			_stopping = true;
+		}
+		_wake.notify_all();
+		for (auto& worker : _workers)
+		{
+			worker.join();
+		}
+	}
+
+	void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		if (_workers.empty() || count == 1)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				task(i);
+			}
+			return;
+		}
+
+		{
+			std::lock_guard lock(_mutex);
+			_task = &task;
+			_count = count;
+			_next.store(0, std::memory_order_relaxed);
+			_busy = _workers.size();
+			_error = nullptr;
+			++_generation;
+		}
+		_wake.notify_all();
+
+		runTasks();
+
+		std::unique_lock lock(_mutex);
+		_done.wait(lock, [this] { return _busy == 0; });
+		_task = nullptr;
+		if (_error)
+		{
+			std::rethrow_exception(std::exchange(_error, nullptr));
+		}
+	}
+
+	void ThreadPool::runTasks()
+	{
+		// Indices are handed out one at a time, so uneven tasks still balance
+		for (size_t i = _next.fetch_add(1, std::memory_order_relaxed); i < _count;
+			 i = _next.fetch_add(1, std::memory_order_relaxed))
+		{
+			try
+			{
+				(*_task)(i);
+			}
+			catch (...)
+			{
+				std::lock_guard lock(_mutex);
+				if (!_error)
+				{
+					_error = std::current_exception();
+				}
+			}
+		}
+	}
+
+	void ThreadPool::workerLoop()
+	{
+		uint64_t seen = 0;
+		while (true)
+		{
+			{
+				std::unique_lock lock(_mutex);
+				_wake.wait(lock, [this, seen] { return _stopping || _generation != seen; });
+				if (_stopping)
+				{
+					return;
+				}
+				seen = _generation;
+			}
+
+			runTasks();
+
+			std::lock_guard lock(_mutex);
+			if (--_busy == 0)
+			{
+				_done.notify_one();
+			}
+		}
+	}
+}
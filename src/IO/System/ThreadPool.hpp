@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sw::io
+{
+	// Fixed set of worker threads running index-parallel loops.
+	// The calling thread takes part in every loop, so a pool of one thread has no workers at all.
+	class ThreadPool
+	{
+	private:
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+		const std::function<void(size_t)>* _task{nullptr};
+		size_t _count{0};
+		std::atomic<size_t> _next{0};
+		size_t _busy{0};
+		uint64_t _generation{0};
+		bool _stopping{false};
+		std::exception_ptr _error;
+
+		void workerLoop();
+		void runTasks();
+
+	public:
+		// 0 threads means one per hardware thread.
+		explicit ThreadPool(size_t threads = 0);
+		~ThreadPool();
+		ThreadPool(const ThreadPool&) = delete;
+		auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+		// Threads working on a loop, the caller included
+		[[nodiscard]]
+		auto size() const noexcept -> size_t
+		{
+			return _workers.size() + 1;
+		}
+
+		// Calls task(i) for every i in [0, count) across the pool and returns once all calls finished.
+		// The first exception thrown by a task is rethrown here.
+		void parallelFor(size_t count, const std::function<void(size_t)>& task);
+	};
+}
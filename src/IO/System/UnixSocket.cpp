@@ -0,0 +1,161 @@
+#include "UnixSocket.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef SW_HAS_UNIX_SOCKETS
+	#include <cerrno>
+	#include <cstring>
+	#include <sys/socket.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+#endif
+
+namespace sw::io
+{
+#ifdef SW_HAS_UNIX_SOCKETS
+	FdStreamBuf::FdStreamBuf(int fd) :
+			_fd(fd)
+	{
+		setg(_input.data(), _input.data(), _input.data());
+		setp(_output.data(), _output.data() + _output.size());
+	}
+
+	FdStreamBuf::~FdStreamBuf()
+	{
+		sync();
+		::close(_fd);
+	}
+
+	auto FdStreamBuf::underflow() -> int_type
+	{
+		ssize_t count = 0;
+		do
+		{
+			count = ::read(_fd, _input.data(), _input.size());
+		} while (count < 0 && errno == EINTR);
+
+		if (count <= 0)
+		{
+			return traits_type::eof();
+		}
+		setg(_input.data(), _input.data(), _input.data() + count);
+		return traits_type::to_int_type(*gptr());
+	}
+
+	auto FdStreamBuf::overflow(int_type ch) -> int_type
+	{
+		if (sync() != 0)
+		{
+			return traits_type::eof();
+		}
+		if (!traits_type::eq_int_type(ch, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(ch);
+			pbump(1);
+		}
+		return traits_type::not_eof(ch);
+	}
+
+	auto FdStreamBuf::sync() -> int
+	{
+		const char* data = pbase();
+		while (data < pptr())
+		{
+			const ssize_t written = ::write(_fd, data, static_cast<size_t>(pptr() - data));
+			if (written < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (written <= 0)
+			{
+				return -1;
+			}
+			data += written;
+		}
+		setp(_output.data(), _output.data() + _output.size());
+		return 0;
+	}
+
+	UnixSocketServer::UnixSocketServer(std::string path) :
+			_path(std::move(path))
+	{
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (_path.size() >= sizeof(address.sun_path))
+		{
+			throw std::runtime_error("Socket path is too long: " + _path);
+		}
+		std::memcpy(address.sun_path, _path.c_str(), _path.size() + 1);
+
+		_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if (_fd < 0)
+		{
+			throw std::runtime_error("Failed to create socket: " + std::string(std::strerror(errno)));
+		}
+
+		::unlink(_path.c_str());
+		if (::bind(_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(_fd, 8) != 0)
+		{
+			const std::string reason = std::strerror(errno);
+			::close(_fd);
+			throw std::runtime_error("Failed to listen on " + _path + ": " + reason);
+		}
+	}
+
+	UnixSocketServer::~UnixSocketServer()
+	{
+		::close(_fd);
+		::unlink(_path.c_str());
+	}
+
+	auto UnixSocketServer::accept() -> int
+	{
+		int client = -1;
+		do
+		{
+			client = ::accept(_fd, nullptr, nullptr);
+		} while (client < 0 && errno == EINTR);
+
+		if (client < 0)
+		{
+			throw std::runtime_error("Failed to accept connection: " + std::string(std::strerror(errno)));
+		}
+		return client;
+	}
+#else
+	FdStreamBuf::FdStreamBuf(int fd) :
+			_fd(fd)
+	{}
+
+	FdStreamBuf::~FdStreamBuf() = default;
+
+	auto FdStreamBuf::underflow() -> int_type
+	{
+		return traits_type::eof();
+	}
+
+	auto FdStreamBuf::overflow(int_type) -> int_type
+	{
+		return traits_type::eof();
+	}
+
+	auto FdStreamBuf::sync() -> int
+	{
+		return -1;
+	}
+
+	UnixSocketServer::UnixSocketServer(std::string path) :
+			_path(std::move(path))
+	{
+		throw std::runtime_error("Unix domain sockets are not supported on this platform");
+	}
+
+	UnixSocketServer::~UnixSocketServer() = default;
+
+	auto UnixSocketServer::accept() -> int
+	{
+		return -1;
+	}
+#endif
+}
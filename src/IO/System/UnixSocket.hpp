@@ -0,0 +1,65 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define SW_HAS_UNIX_SOCKETS 1
+#endif
+
+#include <array>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+namespace sw::io
+{
+	// Buffered streambuf over a connected file descriptor; closes it on destruction.
+	class FdStreamBuf : public std::streambuf
+	{
+	private:
+		int _fd;
+		std::array<char, 4096> _input{};
+		std::array<char, 4096> _output{};
+
+	public:
+		explicit FdStreamBuf(int fd);
+		~FdStreamBuf() override;
+		FdStreamBuf(const FdStreamBuf&) = delete;
+		auto operator=(const FdStreamBuf&) -> FdStreamBuf& = delete;
+
+	protected:
+		auto underflow() -> int_type override;
+		auto overflow(int_type ch) -> int_type override;
+		auto sync() -> int override;
+	};
+
+	// Bidirectional stream over one accepted socket connection.
+	class SocketStream : public std::iostream
+	{
+	private:
+		FdStreamBuf _buffer;
+
+	public:
+		explicit SocketStream(int fd) :
+				std::iostream(nullptr),
+				_buffer(fd)
+		{
+			rdbuf(&_buffer);
+		}
+	};
+
+	// Listening Unix domain socket; the socket file is removed on destruction.
+	class UnixSocketServer
+	{
+	private:
+		std::string _path;
+		int _fd{-1};
+
+	public:
+		explicit UnixSocketServer(std::string path);
+		~UnixSocketServer();
+		UnixSocketServer(const UnixSocketServer&) = delete;
+		auto operator=(const UnixSocketServer&) -> UnixSocketServer& = delete;
+
+		// Blocks until a client connects and returns the connection descriptor.
+		auto accept() -> int;
+	};
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "Varint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace sw::io::details
+{
+	// Columns of an event archive block; every event field is stored in one of them.
+	enum class ArchiveColumn : uint8_t
+	{
+		Turn,
+		Type,
+		Unit,
+		X,
+		Y,
+		Value,
+		Text
+	};
+
+	inline constexpr size_t ArchiveColumnCount = 7;
+
+	// Ids and coordinates change little between neighbouring events, so their columns are delta-coded.
+	inline auto columnOf(std::string_view field) -> ArchiveColumn
+	{
+		if (field == "unitId" || field.ends_with("UnitId"))
+		{
+			return ArchiveColumn::Unit;
+		}
+		if (field == "x" || field == "targetX")
+		{
+			return ArchiveColumn::X;
+		}
+		if (field == "y" || field == "targetY")
+		{
+			return ArchiveColumn::Y;
+		}
+		return ArchiveColumn::Value;
+	}
+
+	// Column buffers of the block being written, with the last value of each delta-coded column.
+	struct ArchiveBlock
+	{
+		std::array<std::string, ArchiveColumnCount> columns;
+		std::array<uint32_t, ArchiveColumnCount> previous{};
+		uint32_t eventCount = 0;
+		uint32_t firstTurn = 0;
+		uint32_t lastTurn = 0;
+
+		void clear()
+		{
+			for (auto& column : columns)
+			{
+				column.clear();
+			}
+			previous = {};
+			eventCount = 0;
+		}
+
+		void putDelta(ArchiveColumn column, uint32_t value)
+		{
+			const auto index = static_cast<size_t>(column);
+			putVarint(columns[index], zigzag(int64_t{value} - previous[index]));
+			previous[index] = value;
+		}
+
+		void begin(uint32_t turn, uint32_t type)
+		{
+			firstTurn = eventCount == 0 ? turn : std::min(firstTurn, turn);
+			lastTurn = eventCount == 0 ? turn : std::max(lastTurn, turn);
+			++eventCount;
+			putDelta(ArchiveColumn::Turn, turn);
+			columns[static_cast<size_t>(ArchiveColumn::Type)].push_back(static_cast<char>(type));
+		}
+	};
+
+	// Appends event fields to the columns of a block.
+	class ColumnEncoder
+	{
+	private:
+		ArchiveBlock& _block;
+
+	public:
+		explicit ColumnEncoder(ArchiveBlock& block) :
+				_block(block)
+		{}
+
+		template <typename T>
+		void visit(const char* name, const T& value)
+		{
+			if constexpr (std::is_same_v<T, std::string>)
+			{
+				auto& text = _block.columns[static_cast<size_t>(ArchiveColumn::Text)];
+				putVarint(text, value.size());
+				text.append(value);
+			}
+			else
+			{
+				static_assert(std::is_same_v<T, uint32_t>, "archived event fields are uint32_t or std::string");
+				const ArchiveColumn column = columnOf(name);
+				if (column == ArchiveColumn::Value)
+				{
+					putVarint(_block.columns[static_cast<size_t>(column)], value);
+				}
+				else
+				{
+					_block.putDelta(column, value);
+				}
+			}
+		}
+	};
+
+	// Reads event fields back from the columns of one block, in the order they were written.
+	class ColumnDecoder
+	{
+	private:
+		std::array<VarintReader, ArchiveColumnCount> _columns;
+		std::array<uint32_t, ArchiveColumnCount> _previous{};
+
+		auto reader(ArchiveColumn column) -> VarintReader&
+		{
+			return _columns[static_cast<size_t>(column)];
+		}
+
+		auto delta(ArchiveColumn column) -> uint32_t
+		{
+			uint32_t& previous = _previous[static_cast<size_t>(column)];
+			previous = static_cast<uint32_t>(previous + reader(column).nextSigned());
+			return previous;
+		}
+
+	public:
+		explicit ColumnDecoder(const std::array<std::span<const char>, ArchiveColumnCount>& columns)
+		{
+			for (size_t i = 0; i < columns.size(); ++i)
+			{
+				_columns[i] = VarintReader(columns[i]);
+			}
+		}
+
+		auto turn() -> uint32_t
+		{
+			return delta(ArchiveColumn::Turn);
+		}
+
+		auto type() -> uint8_t
+		{
+			return reader(ArchiveColumn::Type).byte();
+		}
+
+		template <typename T>
+		void visit(const char* name, T& value)
+		{
+			if constexpr (std::is_same_v<T, std::string>)
+			{
+				value = reader(ArchiveColumn::Text).text();
+			}
+			else
+			{
+				const ArchiveColumn column = columnOf(name);
+				value = column == ArchiveColumn::Value ? static_cast<uint32_t>(reader(column).next()) : delta(column);
+			}
+		}
+	};
+}
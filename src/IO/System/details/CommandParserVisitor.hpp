@@ -1,6 +1,8 @@
 #pragma once
 
 #include <iostream>
+#include <optional>
+#include <vector>
 
 namespace sw
 {
@@ -19,5 +21,25 @@ namespace sw
 		{
 			_stream >> field;
 		}
+
+		// Optional trailing fields stay empty when the line ends before them.
+		template <class TField>
+		void visit(const char*, std::optional<TField>& field)
+		{
+			if (TField value; _stream >> value)
+			{
+				field = value;
+			}
+		}
+
+		// Trailing lists take every remaining value on the line.
+		template <class TField>
+		void visit(const char*, std::vector<TField>& field)
+		{
+			for (TField value; _stream >> value;)
+			{
+				field.push_back(value);
+			}
+		}
 	};
 }
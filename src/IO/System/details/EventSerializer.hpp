@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace sw::io::details
+{
+	inline constexpr size_t MaxEventFields = 16;
+
+	// Field names of an event, collected by running its visit() during constant evaluation.
+	struct EventFieldNames
+	{
+		std::array<const char*, MaxEventFields> names{};
+		size_t count = 0;
+
+		template <typename T>
+		constexpr void visit(const char* name, const T&)
+		{
+			names.at(count++) = name;
+		}
+	};
+
+	template <class TEvent>
+	constexpr auto eventFieldNames() -> EventFieldNames
+	{
+		TEvent event{};
+		EventFieldNames fields;
+		event.visit(fields);
+		return fields;
+	}
+
+	// Constant text of an event line, split around its values:
+	// piece 0 is " NAME firstField=", piece i is " field=", piece FieldCount ends the line.
+	// An event without fields is a single piece.
+	template <size_t TextSize, size_t FieldCount>
+	struct EventLineLayout
+	{
+		std::array<char, TextSize> text{};
+		std::array<size_t, FieldCount + 2> bounds{};
+
+		[[nodiscard]]
+		constexpr auto piece(size_t index) const -> std::string_view
+		{
+			return {text.data() + bounds[index], bounds[index + 1] - bounds[index]};
+		}
+	};
+
+	// Writes the pieces of an event line to text (when not null) and returns their total length.
+	template <class TEvent>
+	constexpr auto layEventLine(const EventFieldNames& fields, char* text, size_t* bounds) -> size_t
+	{
+		size_t size = 0;
+		const auto put = [&](std::string_view part)
+		{
+			for (const char c : part)
+			{
+				if (text != nullptr)
+				{
+					text[size] = c;
+				}
+				++size;
+			}
+		};
+		const auto bound = [&](size_t index)
+		{
+			if (bounds != nullptr)
+			{
+				bounds[index] = size;
+			}
+		};
+
+		bound(0);
+		put(" ");
+		put(TEvent::Name);
+		put(" ");
+		for (size_t i = 0; i < fields.count; ++i)
+		{
+			if (i > 0)
+			{
+				bound(i);
+				put(" ");
+			}
+			put(fields.names[i]);
+			put("=");
+		}
+		if (fields.count > 0)
+		{
+			bound(fields.count);
+			put(" ");
+		}
+		put("\n");
+		bound(fields.count + 1);
+		return size;
+	}
+
+	template <class TEvent>
+	constexpr auto eventLineLayout()
+	{
+		constexpr EventFieldNames fields = eventFieldNames<TEvent>();
+		constexpr size_t size = layEventLine<TEvent>(fields, nullptr, nullptr);
+		EventLineLayout<size, fields.count> layout;
+		layEventLine<TEvent>(fields, layout.text.data(), layout.bounds.data());
+		return layout;
+	}
+
+	// Formats events as "<turn> NAME field=value ... " lines, the text printed by the event log.
+	// The constant text is generated at compile time from the event's visit(); at run time only the
+	// values are formatted, with std::to_chars, between appends of the precomputed pieces.
+	template <class TEvent>
+	class EventSerializer
+	{
+	private:
+		static constexpr auto Layout = eventLineLayout<TEvent>();
+		static constexpr size_t FieldCount = Layout.bounds.size() - 2;
+
+		struct ValueWriter
+		{
+			std::string& out;
+			size_t field = 0;
+
+			template <typename T>
+			void visit(const char*, const T& value)
+			{
+				if (field > 0)
+				{
+					out.append(Layout.piece(field));
+				}
+				++field;
+
+				if constexpr (std::is_same_v<T, std::string>)
+				{
+					out.append(value);
+				}
+				else
+				{
+					static_assert(std::is_integral_v<T>, "event fields are integers or std::string");
+					appendNumber(out, value);
+				}
+			}
+		};
+
+		template <typename T>
+		static void appendNumber(std::string& out, T value)
+		{
+			std::array<char, 24> digits{};
+			const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+			out.append(digits.data(), result.ptr);
+		}
+
+	public:
+		// Appends the event's line, newline included, to out.
+		static void append(std::string& out, uint32_t turn, TEvent& event)
+		{
+			appendNumber(out, turn);
+			out.append(Layout.piece(0));
+			ValueWriter writer{.out = out};
+			event.visit(writer);
+			if constexpr (FieldCount > 0)
+			{
+				out.append(Layout.piece(FieldCount));
+			}
+		}
+	};
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace sw::io::details
+{
+	// LEB128 varints, with zigzag mapping so small negative deltas stay small too.
+	inline auto zigzag(int64_t value) -> uint64_t
+	{
+		return (static_cast<uint64_t>(value) << 1U) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	inline auto unzigzag(uint64_t value) -> int64_t
+	{
+		return static_cast<int64_t>(value >> 1U) ^ -static_cast<int64_t>(value & 1U);
+	}
+
+	inline void putVarint(std::string& out, uint64_t value)
+	{
+		while (value >= 0x80U)
+		{
+			out.push_back(static_cast<char>((value & 0x7FU) | 0x80U));
+			value >>= 7U;
+		}
+		out.push_back(static_cast<char>(value));
+	}
+
+	// Bounds-checked reader over varint-encoded bytes; throws std::runtime_error on truncated input.
+	class VarintReader
+	{
+	private:
+		std::span<const char> _bytes;
+		size_t _offset{0};
+
+		[[noreturn]]
+		static void truncated()
+		{
+			throw std::runtime_error("Truncated varint data");
+		}
+
+	public:
+		VarintReader() = default;
+
+		explicit VarintReader(std::span<const char> bytes) :
+				_bytes(bytes)
+		{}
+
+		auto next() -> uint64_t
+		{
+			uint64_t value = 0;
+			for (uint32_t shift = 0; shift < 64; shift += 7)
+			{
+				if (_offset >= _bytes.size())
+				{
+					truncated();
+				}
+				const auto byte = static_cast<uint8_t>(_bytes[_offset++]);
+				value |= uint64_t{byte & 0x7FU} << shift;
+				if ((byte & 0x80U) == 0)
+				{
+					return value;
+				}
+			}
+			truncated();
+		}
+
+		auto nextSigned() -> int64_t
+		{
+			return unzigzag(next());
+		}
+
+		auto byte() -> uint8_t
+		{
+			if (_offset >= _bytes.size())
+			{
+				truncated();
+			}
+			return static_cast<uint8_t>(_bytes[_offset++]);
+		}
+
+		[[nodiscard]]
+		auto atEnd() const noexcept -> bool
+		{
+			return _offset >= _bytes.size();
+		}
+
+		// Next size bytes as raw data, e.g. a length-prefixed nested record
+		auto take(uint64_t size) -> std::span<const char>
+		{
+			if (size > _bytes.size() - _offset)
+			{
+				truncated();
+			}
+			const auto data = _bytes.subspan(_offset, size);
+			_offset += size;
+			return data;
+		}
+
+		auto text() -> std::string
+		{
+			const auto size = next();
+			const auto data = take(size);
+			return {data.data(), data.size()};
+		}
+	};
+}
@@ -1,87 +1,833 @@
+#include <Core/Replay.hpp>
 #include <Core/Simulation.hpp>
 #include <IO/Commands/CreateMap.hpp>
+#include <IO/Commands/EndScenario.hpp>
 #include <IO/Commands/March.hpp>
+#include <IO/Commands/Spawn.hpp>
+#include <IO/Commands/SpawnBlock.hpp>
+#include <IO/Commands/SpawnGrenadier.hpp>
+#include <IO/Commands/SpawnGrid.hpp>
 #include <IO/Commands/SpawnHunter.hpp>
 #include <IO/Commands/SpawnSwordsman.hpp>
+#include <IO/System/BattleStats.hpp>
 #include <IO/System/CommandParser.hpp>
+#include <IO/System/CommandStream.hpp>
+#include <IO/System/EventArchive.hpp>
+#include <IO/System/EventBus.hpp>
+#include <IO/System/HashTrace.hpp>
+#include <IO/System/ParallelTextSink.hpp>
+#include <IO/System/ThreadPool.hpp>
+#include <IO/System/UnixSocket.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
-int main(int argc, char** argv)
+namespace
 {
-	using namespace sw;
+	struct Options
+	{
+		std::optional<std::string> scenarioFile;
+		std::optional<std::string> resumeFile;
+		sw::core::CheckpointConfig checkpoints;
+		std::optional<uint32_t> seed;
+		std::optional<std::string> hashOutFile;
+		std::optional<std::string> verifyFile;
+		bool daemon = false;
+		std::optional<std::string> socketPath;
+		std::optional<std::string> streamFile;
+		std::vector<std::string> unitCatalogs;
+		bool stats = false;
+		std::optional<uint32_t> eventMask;
+		std::optional<uint32_t> unitFilter;
+		std::optional<std::string> archiveFile;
+		std::optional<std::string> readArchiveFile;
+		std::optional<std::string> replayFile;
+		uint32_t keyframeInterval = 64;
+		std::optional<std::string> readReplayFile;
+		uint32_t atTurn = std::numeric_limits<uint32_t>::max();
+		uint32_t fromTurn = 0;
+		uint32_t toTurn = std::numeric_limits<uint32_t>::max();
+		std::optional<size_t> formatThreads;
+		sw::core::SimulationRules rules;
+	};
 
-	if (argc != 2)
+	void printUsage(const char* program)
 	{
 		std::cerr << "Usage:" << '\n';
-		std::cerr << "  " << argv[0] << " <scenario_file>  - Run simulation with scenario file" << '\n';
-		return 1;
+		std::cerr << "  " << program << " [options] <scenario_file>  - Run simulation with scenario file" << '\n';
+		std::cerr << "  " << program << " [options] --resume <file>  - Continue simulation from a checkpoint" << '\n';
+		std::cerr << "  " << program << " [options] --daemon         - Run scenarios streamed on stdin" << '\n';
+		std::cerr << "  " << program << " [options] --socket <path>  - Run scenarios sent to a Unix socket" << '\n';
+		std::cerr << "  " << program << " [options] --read-archive <file> - Print events from an event archive" << '\n';
+		std::cerr << "  " << program << " [options] --read-replay <file>  - Print the units of a replay at a turn" << '\n';
+		std::cerr << "Options:" << '\n';
+		std::cerr << "  --checkpoint <file>         Checkpoint destination (default: checkpoint.bin)" << '\n';
+		std::cerr << "  --checkpoint-every <turns>  Write a checkpoint every N turns" << '\n';
+		std::cerr << "  --seed <value>              Seed the AI random engine for reproducible runs" << '\n';
+		std::cerr << "  --hash-out <file>           Write the world state hash of every turn to a file" << '\n';
+		std::cerr << "  --verify <file>             Compare per-turn hashes against a --hash-out reference" << '\n';
+		std::cerr << "  --stream <file|->           Feed further commands while running (AT <turn> ... lines)" << '\n';
+		std::cerr << "  --units <file>              Load unit types for SPAWN from a catalog (repeatable)" << '\n';
+		std::cerr << "  --stats                     Print battle totals to stderr when the run ends" << '\n';
+		std::cerr << "  --events <NAME,...>         Only print these event types, e.g. UNIT_DIED,MARCH_ENDED" << '\n';
+		std::cerr << "  --only-unit <id>            Only print events involving this unit" << '\n';
+		std::cerr << "  --archive <file>            Also write all events to a compressed event archive" << '\n';
+		std::cerr << "  --turns <from>-<to>         Turn range printed by --read-archive (default: all)" << '\n';
+		std::cerr << "  --replay <file>             Record end-of-turn unit states to a seekable replay file" << '\n';
+		std::cerr << "  --keyframe-every <turns>    Turns between full replay keyframes (default: 64)" << '\n';
+		std::cerr << "  --at <turn>                 Turn shown by --read-replay (default: the last)" << '\n';
+		std::cerr << "  --format-threads <count>    Format event text in batches on N threads (0: all)" << '\n';
+		std::cerr << "  --sleep-idle                Skip units with nobody nearby until a unit comes close" << '\n';
+		std::cerr << "  --wake-radius <cells>       Distance that wakes sleeping units (default: longest reach)" << '\n';
+		std::cerr << "  --fast-forward              Skip ahead while every unit marches far from the others" << '\n';
+		std::cerr << "  --results-only              Like --fast-forward, without logging the skipped moves" << '\n';
+		std::cerr << "  --repeat-window <turns>     End when a world state repeats within N turns" << '\n';
+		std::cerr << "  --max-quiet-turns <turns>   End after N consecutive turns without damage" << '\n';
+		std::cerr << "  --incremental-ai            Reuse pursuit decisions while nothing changes nearby" << '\n';
+		std::cerr << "  --sticky-targets            Keep attacking the same target while it stays in reach" << '\n';
+		std::cerr << "  --simultaneous              Apply all hits of a turn together at the end of the turn" << '\n';
+		std::cerr << "Daemon scenarios start with CREATE_MAP and run at the next CREATE_MAP, END or end of input."
+				  << '\n';
+		std::cerr << "A failing daemon command prints ERROR and skips the rest of its scenario." << '\n';
+		std::cerr << "--stats, --verify, --archive and --replay cannot be combined with --daemon or --socket."
+				  << '\n';
 	}
 
-	std::ifstream file(argv[1]);
-	if (!file)
+	auto parseOptions(int argc, char** argv) -> std::optional<Options>
 	{
-		throw std::runtime_error("Error: File not found - " + std::string(argv[1]));
+		Options options;
+		options.checkpoints.path = "checkpoint.bin";
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if (arg == "--resume" && hasValue)
+			{
+				options.resumeFile = argv[++i];
+			}
+			else if (arg == "--checkpoint" && hasValue)
+			{
+				options.checkpoints.path = argv[++i];
+			}
+			else if (arg == "--checkpoint-every" && hasValue)
+			{
+				options.checkpoints.interval = static_cast<sw::core::TurnNumber>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--seed" && hasValue)
+			{
+				options.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--hash-out" && hasValue)
+			{
+				options.hashOutFile = argv[++i];
+			}
+			else if (arg == "--verify" && hasValue)
+			{
+				options.verifyFile = argv[++i];
+			}
+			else if (arg == "--stream" && hasValue)
+			{
+				options.streamFile = argv[++i];
+			}
+			else if (arg == "--units" && hasValue)
+			{
+				options.unitCatalogs.emplace_back(argv[++i]);
+			}
+			else if (arg == "--events" && hasValue)
+			{
+				options.eventMask = sw::EventLog::parseEventMask(argv[++i]);
+			}
+			else if (arg.starts_with("--events="))
+			{
+				options.eventMask = sw::EventLog::parseEventMask(arg.substr(arg.find('=') + 1));
+			}
+			else if (arg == "--only-unit" && hasValue)
+			{
+				options.unitFilter = static_cast<uint32_t>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--archive" && hasValue)
+			{
+				options.archiveFile = argv[++i];
+			}
+			else if (arg == "--read-archive" && hasValue)
+			{
+				options.readArchiveFile = argv[++i];
+			}
+			else if (arg == "--replay" && hasValue)
+			{
+				options.replayFile = argv[++i];
+			}
+			else if (arg == "--keyframe-every" && hasValue)
+			{
+				options.keyframeInterval = static_cast<uint32_t>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--read-replay" && hasValue)
+			{
+				options.readReplayFile = argv[++i];
+			}
+			else if (arg == "--at" && hasValue)
+			{
+				options.atTurn = static_cast<uint32_t>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--turns" && hasValue)
+			{
+				const std::string range = argv[++i];
+				const auto dash = range.find('-');
+				options.fromTurn = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+				if (dash != std::string::npos)
+				{
+					options.toTurn = static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+				}
+			}
+			else if (arg == "--format-threads" && hasValue)
+			{
+				options.formatThreads = std::stoul(argv[++i]);
+			}
+			else if (arg == "--stats")
+			{
+				options.stats = true;
+			}
+			else if (arg == "--sleep-idle")
+			{
+				options.rules.sleepIdleUnits = true;
+			}
+			else if (arg == "--wake-radius" && hasValue)
+			{
+				options.rules.wakeRadius = static_cast<sw::core::RangeValue>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--fast-forward")
+			{
+				options.rules.fastForwardMarches = true;
+			}
+			else if (arg == "--results-only")
+			{
+				options.rules.fastForwardMarches = true;
+				options.rules.reportSkippedMoves = false;
+			}
+			else if (arg == "--repeat-window" && hasValue)
+			{
+				options.rules.repeatedStateWindow = static_cast<sw::core::TurnNumber>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--max-quiet-turns" && hasValue)
+			{
+				options.rules.turnsWithoutDamage = static_cast<sw::core::TurnNumber>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--incremental-ai")
+			{
+				options.rules.incrementalAI = true;
+			}
+			else if (arg == "--sticky-targets")
+			{
+				options.rules.stickyTargets = true;
+			}
+			else if (arg == "--simultaneous")
+			{
+				options.rules.simultaneousDamage = true;
+			}
+			else if (arg == "--daemon")
+			{
+				options.daemon = true;
+			}
+			else if (arg == "--socket" && hasValue)
+			{
+				options.daemon = true;
+				options.socketPath = argv[++i];
+			}
+			else if (!arg.starts_with("--") && !options.scenarioFile)
+			{
+				options.scenarioFile = std::string(arg);
+			}
+			else
+			{
+				return std::nullopt;
+			}
+		}
+
+		const int sources = static_cast<int>(options.scenarioFile.has_value())
+						  + static_cast<int>(options.resumeFile.has_value()) + static_cast<int>(options.daemon)
+						  + static_cast<int>(options.readArchiveFile.has_value())
+						  + static_cast<int>(options.readReplayFile.has_value());
+		if (sources != 1)
+		{
+			return std::nullopt;
+		}
+		// These report once when a run ends, which a daemon never does
+		if (options.daemon && (options.stats || options.verifyFile || options.archiveFile || options.replayFile))
+		{
+			return std::nullopt;
+		}
+		return options;
 	}
 
-	core::Simulation simulation;
+	// Prints the archived events of the requested turns, honouring the event and unit filters.
+	void printArchive(const Options& options)
+	{
+		const sw::io::EventArchiveReader archive(*options.readArchiveFile);
+		sw::EventLog log;
+		if (options.eventMask)
+		{
+			log.setPrintMask(*options.eventMask);
+		}
+		log.setUnitFilter(options.unitFilter);
+		archive.forEach(
+			options.fromTurn, options.toTurn, [&log](uint32_t turn, auto& event) { log.log(turn, event); });
+	}
 
-	bool mapCreated = false;
+	// Prints the units of a replay as they stood at the end of the requested turn.
+	void printReplay(const Options& options)
+	{
+		const sw::core::ReplayReader replay(*options.readReplayFile);
+		const auto turn = std::min(options.atTurn, replay.lastTurn());
+		for (const auto& unit : replay.stateAt(turn))
+		{
+			std::cout << turn << " UNIT unitId=" << unit.id << " unitType=" << unit.type << " x=" << unit.position.x
+					  << " y=" << unit.position.y << " hp=" << unit.hp << " faction=" << unit.faction << '\n';
+		}
+	}
 
-	io::CommandParser parser;
-	parser.add<io::CreateMap>(
-		[&simulation, &mapCreated](io::CreateMap command)
+	// Tracks whether the commands read so far form a runnable scenario.
+	struct ScenarioState
+	{
+		bool mapCreated = false;
+		bool skipping = false;	// Daemon mode: a command failed, ignore the rest of its scenario
+	};
+
+	void runPendingScenario(sw::core::Simulation& simulation, ScenarioState& scenario)
+	{
+		if (scenario.mapCreated && (simulation.getActiveUnitCount() > 1 || simulation.hasPendingCommands()))
+		{
+			simulation.runSimulation();
+		}
+		scenario.mapCreated = false;
+	}
+
+	// Spawns columns x rows copies of one unit, `spacing` cells apart, for SPAWN_BLOCK and SPAWN_GRID.
+	struct GridSpawn
+	{
+		const std::string& unitType;
+		uint32_t unitId;
+		uint32_t x;
+		uint32_t y;
+		uint32_t columns;
+		uint32_t rows;
+		uint32_t spacing;
+		std::span<const uint32_t> values;
+	};
+
+	void spawnGrid(sw::core::Simulation& simulation, const GridSpawn& grid)
+	{
+		const auto fail = [&grid]()
+		{
+			return std::runtime_error(
+				"Failed to spawn " + grid.unitType + " block at position (" + std::to_string(grid.x) + ","
+				+ std::to_string(grid.y) + ")");
+		};
+
+		// A block larger than the map can never fit; reject it before allocating positions
+		const auto dimensions = simulation.world().map().dimensions();
+		const uint64_t count = uint64_t{grid.columns} * grid.rows;
+		if (count > uint64_t{dimensions.width} * dimensions.height)
 		{
-			if (!simulation.createMap(command.width, command.height))
+			throw fail();
+		}
+
+		const auto prototype = simulation.makePrototype(grid.unitType, grid.values);
+		std::vector<sw::core::Position> positions;
+		positions.reserve(count);
+		for (uint32_t row = 0; row < grid.rows; ++row)
+		{
+			for (uint32_t column = 0; column < grid.columns; ++column)
 			{
-				throw std::runtime_error("Failed to create map");
+				const uint64_t x = grid.x + (uint64_t{column} * grid.spacing);
+				const uint64_t y = grid.y + (uint64_t{row} * grid.spacing);
+				if (x >= dimensions.width || y >= dimensions.height)
+				{
+					throw fail();
+				}
+				positions.push_back({.x = static_cast<uint32_t>(x), .y = static_cast<uint32_t>(y)});
 			}
-			mapCreated = true;
-		});
+		}
+
+		if (!simulation.spawnBlock(*prototype, grid.unitId, positions))
+		{
+			throw fail();
+		}
+	}
+
+	// Only commands that add to or steer a running battle may be scheduled with AT; setup and control
+	// commands such as CREATE_MAP and END would tear the battle down partway through a turn.
+	void requireDeferrable(const std::string& commandLine)
+	{
+		std::string commandName;
+		std::istringstream(commandLine) >> commandName;
+		static constexpr std::string_view Deferrable[] = {
+			sw::io::SpawnSwordsman::Name,
+			sw::io::SpawnHunter::Name,
+			sw::io::SpawnGrenadier::Name,
+			sw::io::Spawn::Name,
+			sw::io::SpawnBlock::Name,
+			sw::io::SpawnGrid::Name,
+			sw::io::March::Name};
+		if (std::ranges::find(Deferrable, commandName) == std::end(Deferrable))
+		{
+			throw std::runtime_error(
+				"AT cannot schedule " + commandName + ": only spawn and MARCH commands can be deferred");
+		}
+	}
+
+	void registerScenarioCommands(
+		sw::io::CommandParser& parser, sw::core::Simulation& simulation, ScenarioState& scenario)
+	{
+		simulation.setCommandInterpreter([&parser](const std::string& commandLine) { parser.execute(commandLine); });
+		parser.onDeferred(
+			[&simulation](uint32_t turn, std::string commandLine)
+			{
+				requireDeferrable(commandLine);
+				simulation.scheduleCommand(turn, std::move(commandLine));
+			});
+
+		parser.add<sw::io::CreateMap>(
+			[&simulation, &scenario](sw::io::CreateMap command)
+			{
+				if (!simulation.createMap(command.width, command.height))
+				{
+					throw std::runtime_error("Failed to create map");
+				}
+				scenario.mapCreated = true;
+			});
+
+		parser.add<sw::io::SpawnSwordsman>(
+			[&simulation](const sw::io::SpawnSwordsman& command)
+			{
+				if (!simulation.spawnSwordsman(
+						command.unitId,
+						command.x,
+						command.y,
+						command.hp,
+						command.strength,
+						command.faction.value_or(sw::core::NoFaction)))
+				{
+					throw std::runtime_error(
+						"Failed to spawn swordsman at position (" + std::to_string(command.x) + ","
+						+ std::to_string(command.y) + ")");
+				}
+			});
 
-	parser.add<io::SpawnSwordsman>(
-		[&simulation](const io::SpawnSwordsman& command)
+		parser.add<sw::io::SpawnHunter>(
+			[&simulation](const sw::io::SpawnHunter& command)
+			{
+				if (!simulation.spawnHunter(
+						command.unitId,
+						command.x,
+						command.y,
+						command.hp,
+						command.agility,
+						command.strength,
+						command.range,
+						command.faction.value_or(sw::core::NoFaction)))
+				{
+					throw std::runtime_error(
+						"Failed to spawn hunter at position (" + std::to_string(command.x) + "," + std::to_string(command.y)
+						+ ")");
+				}
+			});
+
+		parser.add<sw::io::SpawnGrenadier>(
+			[&simulation](const sw::io::SpawnGrenadier& command)
+			{
+				if (!simulation.spawnGrenadier(
+						command.unitId,
+						command.x,
+						command.y,
+						command.hp,
+						command.strength,
+						command.power,
+						command.range,
+						command.radius,
+						command.faction.value_or(sw::core::NoFaction)))
+				{
+					throw std::runtime_error(
+						"Failed to spawn grenadier at position (" + std::to_string(command.x) + ","
+						+ std::to_string(command.y) + ")");
+				}
+			});
+
+		parser.add<sw::io::Spawn>(
+			[&simulation](const sw::io::Spawn& command)
+			{
+				const auto* unitTemplate = simulation.unitCatalog().find(command.unitType);
+				if (unitTemplate == nullptr)
+				{
+					throw std::runtime_error("Unknown unit type: " + command.unitType);
+				}
+
+				// One value past the type's stats is the faction
+				std::span<const uint32_t> stats = command.values;
+				auto faction = sw::core::NoFaction;
+				if (stats.size() == unitTemplate->stats.size() + 1)
+				{
+					faction = stats.back();
+					stats = stats.first(unitTemplate->stats.size());
+				}
+				if (!simulation.spawnUnit(*unitTemplate, command.unitId, command.x, command.y, stats, faction))
+				{
+					throw std::runtime_error(
+						"Failed to spawn " + command.unitType + " at position (" + std::to_string(command.x) + ","
+						+ std::to_string(command.y) + ")");
+				}
+			});
+
+		parser.add<sw::io::SpawnBlock>(
+			[&simulation](const sw::io::SpawnBlock& command)
+			{
+				spawnGrid(
+					simulation,
+					{.unitType = command.unitType,
+					 .unitId = command.unitId,
+					 .x = command.x,
+					 .y = command.y,
+					 .columns = command.width,
+					 .rows = command.height,
+					 .spacing = 1,
+					 .values = command.values});
+			});
+
+		parser.add<sw::io::SpawnGrid>(
+			[&simulation](const sw::io::SpawnGrid& command)
+			{
+				spawnGrid(
+					simulation,
+					{.unitType = command.unitType,
+					 .unitId = command.unitId,
+					 .x = command.x,
+					 .y = command.y,
+					 .columns = command.columns,
+					 .rows = command.rows,
+					 .spacing = command.spacing,
+					 .values = command.values});
+			});
+
+		parser.add<sw::io::March>(
+			[&simulation](const sw::io::March command)
+			{
+				if (!simulation.setMarchTarget({.unitId=command.unitId, .x=command.targetX, .y=command.targetY}))
+				{
+					throw std::runtime_error(
+					"Failed to set march target for unit " + std::to_string(command.unitId) + " to position ("
+					+ std::to_string(command.targetX) + "," + std::to_string(command.targetY) + "). "
+					"Position may be out of bounds.");
+				}
+			});
+
+		parser.add<sw::io::EndScenario>(
+			[&simulation, &scenario](const sw::io::EndScenario&) { runPendingScenario(simulation, scenario); });
+	}
+
+	// Runs every scenario read from the input, reusing one Simulation so its containers stay warm.
+	// Events go through a batching text sink when a format pool is given.
+	void serveScenarios(
+		std::istream& input, std::ostream& output, sw::core::Simulation& simulation, sw::io::CommandParser& parser,
+		ScenarioState& scenario, sw::io::ThreadPool* formatPool)
+	{
+		std::optional<sw::io::ParallelTextSink> textSink;
+		if (formatPool != nullptr)
+		{
+			textSink.emplace(output, *formatPool);
+		}
+		simulation.eventLog().setOutput(&output);
+		simulation.eventLog().setTextSink(textSink ? &*textSink : nullptr);
+
+		const auto fail = [&](const std::exception& error)
 		{
-			if (!simulation.spawnSwordsman(command.unitId, command.x, command.y, command.hp, command.strength))
+			simulation.eventLog().flush();
+			output << "ERROR " << error.what() << '\n';
+			scenario.mapCreated = false;
+			scenario.skipping = true;
+		};
+		const auto runGuarded = [&]()
+		{
+			try
+			{
+				runPendingScenario(simulation, scenario);
+			}
+			catch (const std::exception& error)
 			{
-				throw std::runtime_error(
-					"Failed to spawn swordsman at position (" + std::to_string(command.x) + ","
-					+ std::to_string(command.y) + ")");
+				fail(error);
 			}
-		});
+		};
 
-	parser.add<io::SpawnHunter>(
-		[&simulation](const io::SpawnHunter& command)
+		scenario.skipping = false;
+		std::string line;
+		while (std::getline(input, line))
 		{
-			if (!simulation.spawnHunter(
-					command.unitId, command.x, command.y, command.hp, command.agility, command.strength, command.range))
+			std::string commandName;
+			std::istringstream(line) >> commandName;
+			if (commandName == sw::io::CreateMap::Name)
+			{
+				// The previous scenario runs first; its failure must not cost the new one
+				runGuarded();
+				scenario.skipping = false;
+			}
+			else if (commandName == sw::io::EndScenario::Name)
+			{
+				scenario.skipping = false;
+			}
+			if (scenario.skipping)
+			{
+				continue;
+			}
+
+			try
 			{
-				throw std::runtime_error(
-					"Failed to spawn hunter at position (" + std::to_string(command.x) + "," + std::to_string(command.y)
-					+ ")");
+				parser.execute(line);
 			}
-		});
+			catch (const std::exception& error)
+			{
+				fail(error);
+			}
+		}
+		runGuarded();
+		simulation.eventLog().flush();
+		simulation.eventLog().setTextSink(nullptr);
+		output.flush();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace sw;
+
+	const auto options = parseOptions(argc, argv);
+	if (!options)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	if (options->readArchiveFile)
+	{
+		printArchive(*options);
+		return 0;
+	}
+	if (options->readReplayFile)
+	{
+		printReplay(*options);
+		return 0;
+	}
+
+	core::Simulation simulation;
+	if (options->seed)
+	{
+		simulation.seedRandom(*options->seed);
+	}
+	simulation.enableCheckpoints(options->checkpoints);
+	simulation.setRules(options->rules);
+	for (const auto& catalog : options->unitCatalogs)
+	{
+		simulation.loadUnitCatalog(catalog);
+	}
 
-	parser.add<io::March>(
-		[&simulation](const io::March command)
+	std::ofstream hashOut;
+	std::unique_ptr<io::HashTraceWriter> hashWriter;
+	if (options->hashOutFile)
+	{
+		hashOut.open(*options->hashOutFile);
+		if (!hashOut)
+		{
+			throw std::runtime_error("Error: Cannot open hash output file - " + *options->hashOutFile);
+		}
+		hashWriter = std::make_unique<io::HashTraceWriter>(hashOut);
+	}
+
+	std::unique_ptr<io::HashTraceVerifier> verifier;
+	if (options->verifyFile)
+	{
+		std::ifstream reference(*options->verifyFile);
+		if (!reference)
 		{
-			if (!simulation.setMarchTarget({.unitId=command.unitId, .x=command.targetX, .y=command.targetY}))
+			throw std::runtime_error("Error: File not found - " + *options->verifyFile);
+		}
+		verifier = std::make_unique<io::HashTraceVerifier>(reference);
+	}
+
+	std::unique_ptr<core::ReplayWriter> replay;
+	// The state before the first turn is recorded as the turn before it
+	auto recordStart = [&replay, &simulation](uint32_t, const io::SimulationStarted& event)
+	{ replay->record(event.turn - 1, simulation.unitStates()); };
+	if (options->replayFile)
+	{
+		replay = std::make_unique<core::ReplayWriter>(*options->replayFile, options->keyframeInterval);
+		simulation.onEvent<io::SimulationStarted>(recordStart);
+	}
+
+	if (hashWriter || verifier || replay)
+	{
+		simulation.setTurnHashListener(
+			[&hashWriter, &verifier, &replay, &simulation](core::TurnNumber turn, uint64_t hash)
 			{
-				throw std::runtime_error(
-				"Failed to set march target for unit " + std::to_string(command.unitId) + " to position ("
-				+ std::to_string(command.targetX) + "," + std::to_string(command.targetY) + "). "
-				"Position may be out of bounds.");
+				if (hashWriter)
+				{
+					hashWriter->record(turn, hash);
+				}
+				if (verifier)
+				{
+					verifier->record(turn, hash);
+				}
+				if (replay)
+				{
+					replay->record(turn, simulation.unitStates());
+				}
+			});
+	}
+
+	if (options->eventMask)
+	{
+		simulation.eventLog().setPrintMask(*options->eventMask);
+	}
+	simulation.eventLog().setUnitFilter(options->unitFilter);
+
+	io::BattleStats stats;
+	EventBus statsBus(stats);
+	if (options->stats)
+	{
+		statsBus.attach(simulation.eventLog());
+	}
+
+	std::unique_ptr<io::EventArchiveWriter> archive;
+	std::optional<EventBus<io::EventArchiveWriter>> archiveBus;
+	if (options->archiveFile)
+	{
+		archive = std::make_unique<io::EventArchiveWriter>(*options->archiveFile);
+		archiveBus.emplace(*archive);
+		archiveBus->attach(simulation.eventLog());
+	}
+
+	std::optional<io::ThreadPool> formatPool;
+	std::optional<io::ParallelTextSink> textSink;
+	if (options->formatThreads)
+	{
+		formatPool.emplace(*options->formatThreads);
+		if (!options->daemon)
+		{
+			textSink.emplace(std::cout, *formatPool);
+			simulation.eventLog().setTextSink(&*textSink);
+		}
+	}
+
+	auto reportResults = [&simulation, &verifier, &stats, &archive, &replay, &options]() -> int
+	{
+		simulation.eventLog().flush();
+		if (replay)
+		{
+			replay->close();
+		}
+		if (options->stats)
+		{
+			stats.report(std::cerr);
+		}
+		if (archive)
+		{
+			archive->close();
+		}
+		if (!verifier)
+		{
+			return 0;
+		}
+
+		verifier->finish();
+		if (!verifier->diverged())
+		{
+			std::cerr << "Replay verified: " << verifier->checkedTurns() << " turns match the reference" << '\n';
+			return 0;
+		}
+
+		const auto& expected = verifier->expected();
+		const auto& actual = verifier->actual();
+		auto describe = [](const std::optional<io::HashTraceVerifier::Entry>& entry) -> std::string
+		{
+			if (!entry)
+			{
+				return "<end of run>";
 			}
-		});
+			std::ostringstream text;
+			io::HashTraceWriter(text).record(entry->turn, entry->hash);
+			return "turn " + text.str().substr(0, text.str().size() - 1);
+		};
+		std::cerr << "Replay diverged at turn " << (actual ? actual->turn : expected->turn) << ": expected "
+				  << describe(expected) << ", got " << describe(actual) << '\n';
+		return 2;
+	};
+
+	if (options->daemon)
+	{
+		ScenarioState scenario;
+		io::CommandParser parser;
+		registerScenarioCommands(parser, simulation, scenario);
+
+		if (!options->socketPath)
+		{
+			serveScenarios(std::cin, std::cout, simulation, parser, scenario, formatPool ? &*formatPool : nullptr);
+			return 0;
+		}
+
+		io::UnixSocketServer server(*options->socketPath);
+		while (true)
+		{
+			io::SocketStream connection(server.accept());
+			serveScenarios(connection, connection, simulation, parser, scenario, formatPool ? &*formatPool : nullptr);
+		}
+	}
+
+	ScenarioState scenario;
+	io::CommandParser parser;
+	registerScenarioCommands(parser, simulation, scenario);
+
+	if (options->resumeFile)
+	{
+		simulation.loadCheckpoint(*options->resumeFile);
+		simulation.runSimulation();
+		return reportResults();
+	}
+
+	std::ifstream file(*options->scenarioFile);
+	if (!file)
+	{
+		throw std::runtime_error("Error: File not found - " + *options->scenarioFile);
+	}
 
 	// Parse commands and execute them
 	parser.parse(file);
 
-	// Run the battle simulation
-	if (mapCreated && simulation.getActiveUnitCount() > 1)
+	std::ifstream streamFile;
+	std::unique_ptr<io::CommandStreamReader> streamReader;
+	if (options->streamFile)
 	{
-		simulation.runSimulation();
+		std::istream* stream = &std::cin;
+		if (*options->streamFile != "-")
+		{
+			streamFile.open(*options->streamFile);
+			if (!streamFile)
+			{
+				throw std::runtime_error("Error: File not found - " + *options->streamFile);
+			}
+			stream = &streamFile;
+		}
+		streamReader = std::make_unique<io::CommandStreamReader>(*stream, parser);
+		simulation.setCommandSource([&streamReader](core::TurnNumber turn)
+									{ return streamReader->readThrough(turn); });
 	}
 
-	return 0;
+	// Run the battle simulation
+	runPendingScenario(simulation, scenario);
+
+	return reportResults();
 }
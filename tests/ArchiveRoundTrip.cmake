@@ -0,0 +1,43 @@
+# Regression check: reading back an event archive must print the events of the run that wrote it, and a
+# turn range must print exactly the lines of those turns.
+# Usage: cmake -DBINARY=<sw_battle_test> -DSCENARIO=<scenario> -DWORK_DIR=<dir> -P ArchiveRoundTrip.cmake
+
+get_filename_component(name "${SCENARIO}" NAME_WE)
+set(archive "${WORK_DIR}/${name}.swa")
+execute_process(
+	COMMAND "${BINARY}" --seed 1 --archive "${archive}" "${SCENARIO}"
+	OUTPUT_VARIABLE live
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Writing the archive failed: ${result}")
+endif()
+
+execute_process(
+	COMMAND "${BINARY}" --read-archive "${archive}"
+	OUTPUT_VARIABLE archived
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Reading the archive failed: ${result}")
+endif()
+if(NOT archived STREQUAL live)
+	message(FATAL_ERROR "The archive differs from the run.\nExpected:\n${live}\nActual:\n${archived}")
+endif()
+
+execute_process(
+	COMMAND "${BINARY}" --read-archive "${archive}" --turns 3-5
+	OUTPUT_VARIABLE ranged
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Reading turns 3-5 failed: ${result}")
+endif()
+
+string(REPLACE "\n" ";" lines "${live}")
+set(expected "")
+foreach(line IN LISTS lines)
+	if(line MATCHES "^([0-9]+) " AND CMAKE_MATCH_1 GREATER_EQUAL 3 AND CMAKE_MATCH_1 LESS_EQUAL 5)
+		string(APPEND expected "${line}\n")
+	endif()
+endforeach()
+if(expected STREQUAL "" OR NOT ranged STREQUAL expected)
+	message(FATAL_ERROR "Turns 3-5 differ from the run.\nExpected:\n${expected}\nActual:\n${ranged}")
+endif()
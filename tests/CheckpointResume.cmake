@@ -0,0 +1,63 @@
+# Regression check: a run resumed from a checkpoint must report the same events, and end the same way,
+# as the run that wrote it.
+# Usage: cmake -DBINARY=<sw_battle_test> -DSCENARIO=<scenario> -DWORK_DIR=<dir> -DEVERY=<turns> [-DOPTIONS=<flags>]
+#        -P CheckpointResume.cmake
+# EVERY must put the last checkpoint before the battle ends; OPTIONS are passed to all three runs.
+
+get_filename_component(name "${SCENARIO}" NAME_WE)
+string(MAKE_C_IDENTIFIER "${name}${OPTIONS}" name)
+set(checkpoint "${WORK_DIR}/${name}.bin")
+
+# Keeps the event lines from the given turn on; only the resumed run logs a second SIMULATION_STARTED
+function(event_lines output first_turn result)
+	string(REPLACE "\n" ";" lines "${output}")
+	set(kept "")
+	foreach(line IN LISTS lines)
+		if(line MATCHES " SIMULATION_STARTED" OR NOT line MATCHES "^([0-9]+) ")
+			continue()
+		endif()
+		if(CMAKE_MATCH_1 GREATER_EQUAL first_turn)
+			list(APPEND kept "${line}")
+		endif()
+	endforeach()
+	list(JOIN kept "\n" kept)
+	set(${result} "${kept}" PARENT_SCOPE)
+endfunction()
+
+execute_process(
+	COMMAND "${BINARY}" --seed 3 ${OPTIONS} "${SCENARIO}"
+	OUTPUT_VARIABLE straight
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "The straight run failed: ${result}")
+endif()
+
+execute_process(
+	COMMAND "${BINARY}" --seed 3 ${OPTIONS} --checkpoint "${checkpoint}" --checkpoint-every ${EVERY} "${SCENARIO}"
+	OUTPUT_QUIET
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "The checkpointed run failed: ${result}")
+endif()
+
+execute_process(
+	COMMAND "${BINARY}" --seed 3 ${OPTIONS} --resume "${checkpoint}"
+	OUTPUT_VARIABLE resumed
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "The resumed run failed: ${result}")
+endif()
+
+if(NOT resumed MATCHES "^([0-9]+) SIMULATION_STARTED")
+	message(FATAL_ERROR "The resumed run did not start:\n${resumed}")
+endif()
+set(first_turn ${CMAKE_MATCH_1})
+
+event_lines("${straight}" ${first_turn} expected)
+event_lines("${resumed}" ${first_turn} actual)
+if(expected STREQUAL "")
+	message(FATAL_ERROR "The straight run has no events from turn ${first_turn}")
+endif()
+if(NOT actual STREQUAL expected)
+	message(FATAL_ERROR "The resumed run diverged from turn ${first_turn}.\nExpected:\n${expected}\nActual:\n${actual}")
+endif()
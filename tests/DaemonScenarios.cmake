@@ -0,0 +1,55 @@
+# Regression check: scenarios streamed to the daemon must print what separate runs of each scenario print,
+# and a scenario rejected part way must report the error without disturbing the next one.
+# Usage: cmake -DBINARY=<sw_battle_test> -DSCENARIOS=<scenario ...> -DREJECTED=<scenario> -DERROR=<message>
+#        -DWORK_DIR=<dir> -P DaemonScenarios.cmake
+# SCENARIOS is a space-separated list; REJECTED is streamed after the first scenario and must fail with ERROR.
+
+separate_arguments(scenarios UNIX_COMMAND "${SCENARIOS}")
+set(input "${WORK_DIR}/daemon_input.txt")
+file(WRITE "${input}" "")
+list(GET scenarios 0 first)
+set(rest "")
+foreach(scenario IN LISTS scenarios)
+	execute_process(
+		COMMAND "${BINARY}" --seed 1 "${scenario}"
+		OUTPUT_VARIABLE output
+		RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "The separate run of ${scenario} failed: ${result}")
+	endif()
+
+	file(READ "${scenario}" commands)
+	file(APPEND "${input}" "${commands}\n")
+	if(scenario STREQUAL first)
+		set(firstOutput "${output}")
+		file(READ "${REJECTED}" commands)
+		file(APPEND "${input}" "${commands}\n")
+	else()
+		string(APPEND rest "${output}")
+	endif()
+endforeach()
+
+execute_process(
+	COMMAND "${BINARY}" --seed 1 --daemon
+	INPUT_FILE "${input}"
+	OUTPUT_VARIABLE actual
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "The daemon failed: ${result}")
+endif()
+
+# The rejected scenario prints its setup events before the error; only its error line is checked
+set(errorLine "ERROR ${ERROR}\n")
+string(FIND "${actual}" "${errorLine}" errorAt)
+if(errorAt EQUAL -1)
+	message(FATAL_ERROR "The daemon did not report \"ERROR ${ERROR}\":\n${actual}")
+endif()
+string(LENGTH "${firstOutput}" firstLength)
+string(LENGTH "${errorLine}" errorLength)
+math(EXPR restAt "${errorAt} + ${errorLength}")
+string(SUBSTRING "${actual}" 0 ${firstLength} actualFirst)
+string(SUBSTRING "${actual}" ${restAt} -1 actualRest)
+if(NOT actualFirst STREQUAL firstOutput OR NOT actualRest STREQUAL rest)
+	message(FATAL_ERROR
+		"The daemon output differs from the separate runs.\nExpected:\n${firstOutput}${errorLine}${rest}\nActual:\n${actual}")
+endif()
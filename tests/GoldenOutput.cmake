@@ -0,0 +1,18 @@
+# Regression check: a scenario run with the given flags must print exactly the recorded events.
+# Usage: cmake -DBINARY=<sw_battle_test> -DSCENARIO=<scenario> -DEXPECTED=<events file> [-DOPTIONS=<flags>]
+#        -P GoldenOutput.cmake
+# OPTIONS is a space-separated flag list; every run is seeded so the AI picks the same targets.
+
+separate_arguments(options UNIX_COMMAND "${OPTIONS}")
+execute_process(
+	COMMAND "${BINARY}" --seed 1 ${options} "${SCENARIO}"
+	OUTPUT_VARIABLE actual
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "The run failed: ${result}")
+endif()
+
+file(READ "${EXPECTED}" expected)
+if(NOT actual STREQUAL expected)
+	message(FATAL_ERROR "The events differ from ${EXPECTED}.\nExpected:\n${expected}\nActual:\n${actual}")
+endif()
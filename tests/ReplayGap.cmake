@@ -0,0 +1,27 @@
+# Regression check: a turn that falls inside a keyframe window but before the window's first recorded
+# frame must still show the last recorded state, not an empty battlefield.
+# Usage: cmake -DBINARY=<sw_battle_test> -DSCENARIO=<replay_gap.txt> -DWORK_DIR=<dir> -P ReplayGap.cmake
+
+set(replay "${WORK_DIR}/replay_gap.swrp")
+execute_process(
+	COMMAND "${BINARY}" --seed 1 --replay "${replay}" "${SCENARIO}"
+	OUTPUT_QUIET
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Recording the replay failed: ${result}")
+endif()
+
+# Nothing happens between the arrival at turn ~9 and the spawn at turn 200, so those turns are not recorded
+foreach(turn 130 195 199)
+	execute_process(
+		COMMAND "${BINARY}" --read-replay "${replay}" --at ${turn}
+		OUTPUT_VARIABLE units
+		RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "Reading turn ${turn} failed: ${result}")
+	endif()
+	if(NOT units MATCHES "unitId=1 unitType=Swordsman x=9 y=0 hp=5"
+	   OR NOT units MATCHES "unitId=3 unitType=Swordsman x=9 y=9 hp=5")
+		message(FATAL_ERROR "Turn ${turn} lost the recorded units:\n${units}")
+	endif()
+endforeach()
@@ -0,0 +1,25 @@
+# Regression check: flags that only change how the run is computed must print the same events as the
+# default run.
+# Usage: cmake -DBINARY=<sw_battle_test> -DSCENARIO=<scenario> -DOPTIONS=<flags> -P SameOutput.cmake
+# OPTIONS is a space-separated flag list.
+
+separate_arguments(options UNIX_COMMAND "${OPTIONS}")
+execute_process(
+	COMMAND "${BINARY}" --seed 1 "${SCENARIO}"
+	OUTPUT_VARIABLE expected
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "The default run failed: ${result}")
+endif()
+
+execute_process(
+	COMMAND "${BINARY}" --seed 1 ${options} "${SCENARIO}"
+	OUTPUT_VARIABLE actual
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "The run with ${OPTIONS} failed: ${result}")
+endif()
+
+if(NOT actual STREQUAL expected)
+	message(FATAL_ERROR "${OPTIONS} changed the events.\nExpected:\n${expected}\nActual:\n${actual}")
+endif()